@@ -0,0 +1,147 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include <c11/lexer/scanner.hpp>
+using namespace c11;
+
+// 生成的测试语料：每种语料突出一类 Token，固定随机种子，不同版本之间的结果可以直接比较
+namespace {
+    constexpr size_t CORPUS_SIZE = 1 << 20;
+
+    // 重复调用 append 直到达到语料大小
+    std::string generate(const std::function<void(std::mt19937 &, std::string &)> &append) {
+        std::mt19937 random(20261015);
+        std::string corpus;
+        corpus.reserve(CORPUS_SIZE + 256);
+        while (corpus.size() < CORPUS_SIZE) append(random, corpus);
+        return corpus;
+    }
+
+    std::string random_identifier(std::mt19937 &random) {
+        static const char *words[] = {"buffer", "count", "node", "next", "value", "index", "table", "state", "len"};
+        std::string name = words[random() % 9];
+        name += '_';
+        name += words[random() % 9];
+        name += std::to_string(random() % 100);
+        return name;
+    }
+
+    // 1. 标识符密集：赋值与函数调用
+    std::string identifier_corpus() {
+        return generate([](std::mt19937 &random, std::string &out) {
+            out += random_identifier(random) + " = " + random_identifier(random) + "(" +
+                    random_identifier(random) + ", " + random_identifier(random) + "->" +
+                    random_identifier(random) + ");\n";
+        });
+    }
+
+    // 2. 注释密集：块注释与行注释交替
+    std::string comment_corpus() {
+        return generate([](std::mt19937 &random, std::string &out) {
+            out += "/*\n * Walks the table and releases every " + random_identifier(random) +
+                    " entry.\n * The caller must hold the lock.\n */\n";
+            out += "int " + random_identifier(random) + "; // " + random_identifier(random) +
+                    " is reset on every pass\n";
+        });
+    }
+
+    // 3. 字符串表：带转义序列的字符串与字符常量
+    std::string string_corpus() {
+        return generate([](std::mt19937 &random, std::string &out) {
+            out += "    { \"" + random_identifier(random) + "\", \"line one\\nline two\\t\\\"quoted\\\"\", '" +
+                    static_cast<char>('a' + random() % 26) + "', '\\n' },\n";
+        });
+    }
+
+    // 4. 数字常量：十进制、十六进制、八进制、带后缀的整数与浮点数
+    std::string numeric_corpus() {
+        return generate([](std::mt19937 &random, std::string &out) {
+            out += "{" + std::to_string(random()) + "u, 0x" + std::to_string(random() % 0xffff) + "UL, 0" +
+                    std::to_string(random() % 7) + std::to_string(random() % 7) + ", " +
+                    std::to_string(random() % 1000) + "." + std::to_string(random() % 1000) + "e-" +
+                    std::to_string(random() % 30) + ", " + std::to_string(random() % 100) + ".5f},\n";
+        });
+    }
+
+    // 5. 错误密集：非法字符、非法整数与非法转义，几乎每行都产生错误
+    std::string error_corpus() {
+        return generate([](std::mt19937 &random, std::string &out) {
+            out += "x @ 08 $ \"bad\\q\" ` " + random_identifier(random) + " 0x;\n";
+        });
+    }
+
+    // 每次迭代使用新的源缓冲区，换行索引等惰性状态不会在迭代之间复用；复制输入不计入耗时
+    void scan_corpus(benchmark::State &state, const Scanner &scanner, const std::string &corpus) {
+        size_t tokens = 0, errors = 0;
+        for (auto _: state) {
+            state.PauseTiming();
+            auto source = SourceBuffer::from_string(corpus);
+            state.ResumeTiming();
+            const ScanResult result = scanner.scan(std::move(source));
+            benchmark::DoNotOptimize(result.tokens.data());
+            tokens = result.tokens.size();
+            errors = result.errors.size();
+        }
+        const auto iterations = static_cast<double>(state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus.size()));
+        state.counters["tokens"] = static_cast<double>(tokens);
+        state.counters["errors"] = static_cast<double>(errors);
+        state.counters["token_rate"] = benchmark::Counter(static_cast<double>(tokens) * iterations,
+                                                          benchmark::Counter::kIsRate);
+        state.counters["MB_rate"] = benchmark::Counter(static_cast<double>(corpus.size()) * iterations / 1e6,
+                                                       benchmark::Counter::kIsRate);
+    }
+
+    // 每种扫描模式只构建一次扫描器
+    const Scanner &scanner_for(const ScanMode mode) {
+        static const Scanner dfa(ScanMode::DFA);
+        static const Scanner regex(ScanMode::REGEX);
+        return mode == ScanMode::DFA ? dfa : regex;
+    }
+
+    void register_corpus(const std::string &name, std::string corpus) {
+        for (const auto &[mode, mode_name]: {std::pair{ScanMode::DFA, "dfa"}, std::pair{ScanMode::REGEX, "regex"}}) {
+            benchmark::RegisterBenchmark(("scan/" + name + "/" + mode_name).c_str(),
+                                         [mode = mode, corpus](benchmark::State &state) {
+                                             scan_corpus(state, scanner_for(mode), corpus);
+                                         })->Unit(benchmark::kMillisecond);
+        }
+    }
+}
+
+// 用法：pocom_bench [Google Benchmark 参数] [C 源文件...]
+// 默认以 JSON 输出到标准输出，--benchmark_out=<file> 可同时写入文件，--benchmark_format=console 恢复表格输出
+int main(int argc, char **argv) {
+    // 1. 未指定输出格式时默认 JSON
+    std::vector<char *> args(argv, argv + argc);
+    std::string json_format = "--benchmark_format=json";
+    bool has_format = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--benchmark_format", 18) == 0) has_format = true;
+    }
+    if (!has_format) args.insert(args.begin() + 1, json_format.data());
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+
+    // 2. 生成的语料，以及命令行中剩余的参数作为本地 C 文件
+    register_corpus("identifiers", identifier_corpus());
+    register_corpus("comments", comment_corpus());
+    register_corpus("strings", string_corpus());
+    register_corpus("numbers", numeric_corpus());
+    register_corpus("errors", error_corpus());
+    for (int i = 1; i < count; ++i) {
+        const std::string path = args[i];
+        register_corpus("file:" + path, std::string(SourceBuffer::from_file(path)->view()));
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,161 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <lexer/regex/engine.hpp>
+#include <lexer/regex/regex_set.hpp>
+#include "catalog.hpp"
+using namespace lexer::regex;
+using bench::Pattern;
+
+// 1. 辅助函数
+namespace {
+    // 用最长匹配切分整个样本，没有匹配时前进 1 字节，返回匹配次数
+    template<typename Automaton>
+    size_t tokenize(const Automaton &dfa, const std::string_view input) {
+        size_t pos = 0, matches = 0;
+        while (pos < input.size()) {
+            const PrefixMatch result = longest_match(dfa, input, pos);
+            pos += result.length ? result.length : 1;
+            matches += result.length != 0;
+        }
+        return matches;
+    }
+}
+
+// 2. 各阶段基准：前一阶段的产物在计时循环外准备好，每个阶段单独计时；内存峰值由单独的 pocom_bench_memory 统计
+namespace {
+    void preprocess_stage(benchmark::State &state, const Pattern &pattern) {
+        for (auto _: state) benchmark::DoNotOptimize(preprocess_regex(pattern.regex));
+    }
+
+    void lexer_stage(benchmark::State &state, const Pattern &pattern) {
+        const std::string processed = preprocess_regex(pattern.regex);
+        for (auto _: state) benchmark::DoNotOptimize(lexer::regex::lexer(processed));
+    }
+
+    void postfix_stage(benchmark::State &state, const Pattern &pattern) {
+        const std::vector<Token> tokens = lexer::regex::lexer(preprocess_regex(pattern.regex));
+        for (auto _: state) benchmark::DoNotOptimize(infix_to_postfix(tokens));
+    }
+
+    void nfa_stage(benchmark::State &state, const Pattern &pattern) {
+        const std::vector<Token> postfix = infix_to_postfix(lexer::regex::lexer(preprocess_regex(pattern.regex)));
+        for (auto _: state) benchmark::DoNotOptimize(build_nfa(postfix));
+        state.counters["nfa_states"] = static_cast<double>(build_nfa(postfix)->states.size());
+    }
+
+    void dfa_stage(benchmark::State &state, const Pattern &pattern) {
+        const std::unique_ptr<NFA> nfa = regex_to_nfa(pattern.regex);
+        for (auto _: state) benchmark::DoNotOptimize(build_dfa(nfa));
+        state.counters["nfa_states"] = static_cast<double>(nfa->states.size());
+        state.counters["dfa_states"] = static_cast<double>(build_dfa(nfa)->states.size());
+    }
+
+    void minimize_stage(benchmark::State &state, const Pattern &pattern) {
+        const std::unique_ptr<DFA> dfa = build_dfa(regex_to_nfa(pattern.regex));
+        for (auto _: state) benchmark::DoNotOptimize(minimize_dfa(*dfa));
+        state.counters["dfa_states"] = static_cast<double>(dfa->states.size());
+        state.counters["min_dfa_states"] = static_cast<double>(minimize_dfa(*dfa)->states.size());
+    }
+
+    void compress_stage(benchmark::State &state, const Pattern &pattern) {
+        const std::unique_ptr<DFA> dfa = minimize_dfa(*build_dfa(regex_to_nfa(pattern.regex)));
+        for (auto _: state) benchmark::DoNotOptimize(compress_dfa(*dfa));
+        state.counters["table_bytes"] = static_cast<double>(compress_dfa(*dfa).table_bytes());
+    }
+
+    // 匹配吞吐量：指针形式的最小 DFA 与扫描器使用的压缩转移表
+    void match_dfa_stage(benchmark::State &state, const Pattern &pattern) {
+        const std::unique_ptr<DFA> dfa = minimize_dfa(*build_dfa(regex_to_nfa(pattern.regex)));
+        size_t matches = 0;
+        for (auto _: state) benchmark::DoNotOptimize(matches = tokenize(*dfa, pattern.sample));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pattern.sample.size()));
+        state.counters["matches"] = static_cast<double>(matches);
+    }
+
+    void match_compact_stage(benchmark::State &state, const Pattern &pattern) {
+        const CompactDFA dfa = compress_dfa(*minimize_dfa(*build_dfa(regex_to_nfa(pattern.regex))));
+        size_t matches = 0;
+        for (auto _: state) benchmark::DoNotOptimize(matches = tokenize(dfa, pattern.sample));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pattern.sample.size()));
+        state.counters["matches"] = static_cast<double>(matches);
+    }
+
+    // 静态注册：名称形如 regex/<模式>/<阶段>，可用 --benchmark_filter=regex/blowup 等筛选
+    const bool registered = [] {
+        using Stage = void (*)(benchmark::State &, const Pattern &);
+        const std::pair<const char *, Stage> stages[] = {
+            {"preprocess", preprocess_stage}, {"lexer", lexer_stage}, {"postfix", postfix_stage},
+            {"nfa", nfa_stage}, {"dfa", dfa_stage}, {"minimize", minimize_stage}, {"compress", compress_stage},
+            {"match_dfa", match_dfa_stage}, {"match_compact", match_compact_stage},
+        };
+        static const std::vector<Pattern> catalog = bench::make_catalog();
+        for (const Pattern &pattern: catalog) {
+            for (const auto &[stage_name, stage]: stages) {
+                benchmark::RegisterBenchmark(("regex/" + pattern.name + "/" + stage_name).c_str(),
+                                             [stage = stage, &pattern](benchmark::State &state) {
+                                                 stage(state, pattern);
+                                             })->Unit(benchmark::kMicrosecond);
+            }
+        }
+        return true;
+    }();
+}
+
+// 3. 多模式匹配：RegexSet 一次扫描与逐个模式匹配的对比，参数为模式数量
+namespace {
+    std::vector<std::string> set_patterns(const size_t count) {
+        std::vector<std::string> patterns;
+        for (size_t i = 0; i < count; ++i) patterns.push_back("key" + std::to_string(i) + "(_[a-z]+)?=[0-9]+");
+        return patterns;
+    }
+
+    std::vector<std::string> set_lines() {
+        std::mt19937 random(20261015);
+        std::vector<std::string> lines;
+        for (int i = 0; i < 4096; ++i) lines.push_back("key" + std::to_string(random() % 256) + "_name=42");
+        return lines;
+    }
+
+    void regex_set_scan(benchmark::State &state) {
+        const RegexSet set(set_patterns(static_cast<size_t>(state.range(0))));
+        const std::vector<std::string> lines = set_lines();
+        size_t bytes = 0;
+        for (const std::string &line: lines) bytes += line.size();
+        for (auto _: state) {
+            for (const std::string &line: lines) benchmark::DoNotOptimize(set.matches(line));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+        state.counters["states"] = static_cast<double>(set.state_count());
+    }
+
+    void regex_loop_scan(benchmark::State &state) {
+        std::vector<CompactDFA> dfas;
+        for (const std::string &pattern: set_patterns(static_cast<size_t>(state.range(0)))) {
+            dfas.push_back(compress_dfa(*minimize_dfa(*build_dfa(regex_to_nfa(pattern)))));
+        }
+        const std::vector<std::string> lines = set_lines();
+        size_t bytes = 0;
+        for (const std::string &line: lines) bytes += line.size();
+        for (auto _: state) {
+            for (const std::string &line: lines) {
+                std::vector<size_t> ids;
+                for (size_t i = 0; i < dfas.size(); ++i) {
+                    if (match(dfas[i], line)) ids.push_back(i);
+                }
+                benchmark::DoNotOptimize(ids);
+            }
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    }
+
+    BENCHMARK(regex_set_scan)->Name("regex_set/set")->Arg(1)->Arg(16)->Arg(256)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(regex_loop_scan)->Name("regex_set/loop")->Arg(1)->Arg(16)->Arg(256)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,113 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <lexer/regex/engine.hpp>
+#include "catalog.hpp"
+using namespace lexer::regex;
+
+// 1. 内存峰值统计：替换全局 operator new/delete，在每块内存前记录其大小
+// 只在本程序中替换，pocom_bench 的吞吐量基准不受影响；计数器为原子变量，其他线程的分配不会造成数据竞争
+namespace {
+    std::atomic<bool> tracking{false};
+    std::atomic<size_t> current_bytes{0};
+    std::atomic<size_t> peak{0};
+    // 头部保持 max_align_t 对齐，返回给调用者的地址对齐方式与 malloc 相同
+    constexpr size_t HEADER = alignof(std::max_align_t);
+
+    void *tracked_allocate(const size_t size) {
+        auto *block = static_cast<char *>(std::malloc(size + HEADER));
+        if (!block) return nullptr;
+        *reinterpret_cast<size_t *>(block) = size;
+        if (tracking.load(std::memory_order_relaxed)) {
+            const size_t now = current_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+            size_t seen = peak.load(std::memory_order_relaxed);
+            while (now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {}
+        }
+        return block + HEADER;
+    }
+
+    void tracked_free(void *pointer) {
+        if (!pointer) return;
+        char *block = static_cast<char *>(pointer) - HEADER;
+        const size_t size = *reinterpret_cast<size_t *>(block);
+        // 统计开始前分配的内存不计入，current_bytes 不会小于 0
+        if (tracking.load(std::memory_order_relaxed)) {
+            size_t seen = current_bytes.load(std::memory_order_relaxed);
+            while (!current_bytes.compare_exchange_weak(seen, seen - std::min(size, seen),
+                                                        std::memory_order_relaxed)) {}
+        }
+        std::free(block);
+    }
+
+    // 执行一次 func，返回期间相对开始时新增的内存峰值（字节）
+    template<typename Func>
+    size_t peak_bytes(Func &&func) {
+        current_bytes = 0;
+        peak = 0;
+        tracking = true;
+        func();
+        tracking = false;
+        return peak;
+    }
+}
+
+void *operator new(const size_t size) {
+    if (void *pointer = tracked_allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new(const size_t size, const std::nothrow_t &) noexcept { return tracked_allocate(size); }
+void operator delete(void *pointer) noexcept { tracked_free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { tracked_free(pointer); }
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { tracked_free(pointer); }
+
+// 2. 各阶段的内存峰值：前一阶段的产物在统计之外准备好，每个阶段单独统计
+namespace {
+    std::vector<std::pair<std::string, size_t> > stage_peaks(const bench::Pattern &pattern) {
+        const std::string processed = preprocess_regex(pattern.regex);
+        const std::vector<Token> tokens = lexer::regex::lexer(processed);
+        const std::vector<Token> postfix = infix_to_postfix(tokens);
+        const std::unique_ptr<NFA> nfa = build_nfa(postfix);
+        const std::unique_ptr<DFA> dfa = build_dfa(nfa);
+        const std::unique_ptr<DFA> minimal = minimize_dfa(*dfa);
+        return {
+            {"preprocess", peak_bytes([&] { preprocess_regex(pattern.regex); })},
+            {"lexer", peak_bytes([&] { lexer::regex::lexer(processed); })},
+            {"postfix", peak_bytes([&] { infix_to_postfix(tokens); })},
+            {"nfa", peak_bytes([&] { build_nfa(postfix); })},
+            {"dfa", peak_bytes([&] { build_dfa(nfa); })},
+            {"minimize", peak_bytes([&] { minimize_dfa(*dfa); })},
+            {"compress", peak_bytes([&] { compress_dfa(*minimal); })},
+        };
+    }
+}
+
+// 用法：pocom_bench_memory [名称子串]
+// 以 JSON 输出各模式各阶段的内存峰值，名称与 pocom_bench 中的阶段基准一致，例如 regex/blowup_12/dfa
+int main(const int argc, char **argv) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+    std::cout << "{\n  \"peak_bytes\": [";
+    bool first = true;
+    for (const bench::Pattern &pattern: bench::make_catalog()) {
+        for (const auto &[stage, bytes]: stage_peaks(pattern)) {
+            const std::string name = "regex/" + pattern.name + "/" + stage;
+            if (name.find(filter) == std::string::npos) continue;
+            std::cout << (first ? "\n" : ",\n") << "    {\"name\": \"" << name << "\", \"peak_bytes\": " << bytes << "}";
+            first = false;
+        }
+    }
+    std::cout << "\n  ]\n}\n";
+    return 0;
+}
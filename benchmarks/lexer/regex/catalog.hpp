@@ -0,0 +1,74 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_BENCH_CATALOG_HPP
+#define POCOM_BENCH_CATALOG_HPP
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <c11/lexer/keywords.hpp>
+
+// 正则目录：pocom_bench 的阶段与匹配基准、pocom_bench_memory 的内存峰值统计共用同一组模式
+namespace bench {
+    // 正则目录中的一项：名称、正则与一段用于测量匹配吞吐量的样本输入
+    struct Pattern {
+        std::string name;
+        std::string regex;
+        std::string sample;
+    };
+
+    inline constexpr size_t SAMPLE_SIZE = 64 * 1024;
+
+    // 重复 piece 生成的片段直到达到样本大小
+    template<typename Func>
+    std::string make_sample(Func &&piece) {
+        std::mt19937 random(20261015);
+        std::string sample;
+        while (sample.size() < SAMPLE_SIZE) sample += piece(random);
+        return sample;
+    }
+
+    inline std::vector<Pattern> make_catalog() {
+        std::vector<Pattern> catalog;
+        // 关键字选择：44 个分支共享前缀
+        std::string keywords;
+        for (const std::string_view keyword: c11::KEYWORDS) {
+            keywords += (keywords.empty() ? "" : "|") + std::string(keyword);
+        }
+        catalog.push_back({"keywords", keywords, make_sample([](std::mt19937 &random) {
+            return std::string(c11::KEYWORDS[random() % c11::KEYWORDS.size()]) + " ";
+        })});
+        // 字符类与闭包
+        catalog.push_back({"identifier", "[a-zA-Z_][a-zA-Z0-9_]*", make_sample([](std::mt19937 &random) {
+            return "node_" + std::to_string(random() % 100000) + " ";
+        })});
+        catalog.push_back({
+            "float", "([0-9]+\\.[0-9]*|\\.[0-9]+)([eE][+-]?[0-9]+)?[fFlL]?", make_sample([](std::mt19937 &random) {
+                return std::to_string(random() % 1000) + "." + std::to_string(random() % 1000) + "e-7f ";
+            })
+        });
+        catalog.push_back({"string", "\"([^\"\\\\\\n]|\\\\.)*\"", make_sample([](std::mt19937 &random) {
+            return "\"entry " + std::to_string(random() % 1000) + "\\t\\\"x\\\"\" ";
+        })});
+        // 嵌套闭包：NFA 中 ε 环层层嵌套
+        catalog.push_back({"nested_stars", "((a*b*)*c*)*d", make_sample([](std::mt19937 &random) {
+            std::string piece;
+            for (int i = 0; i < 16; ++i) piece += static_cast<char>('a' + random() % 3);
+            return piece + "d";
+        })});
+        // 子集构造的指数爆炸：(a|b)*a(a|b){n} 的最小 DFA 有 2^(n+1) 个状态
+        for (const int n: {4, 8, 12}) {
+            catalog.push_back({
+                "blowup_" + std::to_string(n), "(a|b)*a(a|b){" + std::to_string(n) + "}",
+                make_sample([](std::mt19937 &random) { return std::string(1, "ab"[random() % 2]); })
+            });
+        }
+        return catalog;
+    }
+}
+
+#endif //POCOM_BENCH_CATALOG_HPP
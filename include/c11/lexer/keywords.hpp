@@ -0,0 +1,98 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_KEYWORDS_HPP
+#define POCOM_KEYWORDS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// C11 关键字表（C11 标准 6.4.1），新增关键字只需加入该表，完美哈希的种子在编译期重新搜索
+namespace c11 {
+    inline constexpr std::array<std::string_view, 44> KEYWORDS = {
+        "auto", "break", "case", "char", "const", "continue", "default", "do",
+        "double", "else", "enum", "extern", "float", "for", "goto", "if",
+        "inline", "int", "long", "register", "restrict", "return", "short", "signed",
+        "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+        "volatile", "while", "_Alignas", "_Alignof", "_Atomic", "_Bool", "_Complex", "_Generic",
+        "_Imaginary", "_Noreturn", "_Static_assert", "_Thread_local"
+    };
+}
+
+// 编译期生成的完美哈希：按长度、首两个字节与末两个字节做 FNV-1a 混合，种子保证关键字之间无冲突
+namespace c11::keyword_hash {
+    inline constexpr size_t TABLE_SIZE = 256;
+
+    constexpr size_t min_length() {
+        size_t length = KEYWORDS[0].size();
+        for (const auto keyword: KEYWORDS) length = keyword.size() < length ? keyword.size() : length;
+        return length;
+    }
+
+    constexpr size_t max_length() {
+        size_t length = 0;
+        for (const auto keyword: KEYWORDS) length = keyword.size() > length ? keyword.size() : length;
+        return length;
+    }
+
+    inline constexpr size_t MIN_LENGTH = min_length();
+    inline constexpr size_t MAX_LENGTH = max_length();
+    static_assert(MIN_LENGTH >= 2, "keyword hash reads the first and last two bytes");
+
+    // 调用方保证 MIN_LENGTH <= word.size()
+    constexpr size_t hash(const std::string_view word, const uint32_t seed) {
+        const uint32_t parts[] = {
+            static_cast<uint32_t>(word.size()), static_cast<unsigned char>(word[0]),
+            static_cast<unsigned char>(word[1]), static_cast<unsigned char>(word[word.size() - 2]),
+            static_cast<unsigned char>(word[word.size() - 1])
+        };
+        uint32_t h = 0x811c9dc5u ^ seed;
+        for (const uint32_t part: parts) h = (h ^ part) * 0x01000193u;
+        h ^= h >> 16;
+        return h & (TABLE_SIZE - 1);
+    }
+
+    // 搜索第一个使所有关键字落入不同槽位的种子
+    constexpr uint32_t find_seed() {
+        for (uint32_t seed = 0; seed < 4096; ++seed) {
+            std::array<bool, TABLE_SIZE> used{};
+            bool collision = false;
+            for (const auto keyword: KEYWORDS) {
+                const size_t slot = hash(keyword, seed);
+                if (used[slot]) {
+                    collision = true;
+                    break;
+                }
+                used[slot] = true;
+            }
+            if (!collision) return seed;
+        }
+        return UINT32_MAX;
+    }
+
+    inline constexpr uint32_t SEED = find_seed();
+    static_assert(SEED != UINT32_MAX, "no collision-free seed, enlarge TABLE_SIZE");
+
+    // 槽位 -> 关键字下标 + 1，0 表示空槽
+    constexpr std::array<uint8_t, TABLE_SIZE> build_table() {
+        std::array<uint8_t, TABLE_SIZE> table{};
+        for (size_t i = 0; i < KEYWORDS.size(); ++i) table[hash(KEYWORDS[i], SEED)] = static_cast<uint8_t>(i + 1);
+        return table;
+    }
+
+    inline constexpr std::array<uint8_t, TABLE_SIZE> TABLE = build_table();
+}
+
+namespace c11 {
+    // 关键字判断：一次长度检查、一次哈希查表与一次等长比较，不分配内存
+    constexpr bool is_c11_keyword(const std::string_view word) {
+        if (word.size() < keyword_hash::MIN_LENGTH || word.size() > keyword_hash::MAX_LENGTH) return false;
+        const uint8_t entry = keyword_hash::TABLE[keyword_hash::hash(word, keyword_hash::SEED)];
+        return entry != 0 && KEYWORDS[entry - 1] == word;
+    }
+}
+
+#endif //POCOM_KEYWORDS_HPP
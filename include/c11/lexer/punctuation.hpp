@@ -0,0 +1,91 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_PUNCTUATION_HPP
+#define POCOM_PUNCTUATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// 运算符与标点符号表，: 同时属于两者
+namespace c11 {
+    inline constexpr std::array<std::string_view, 37> OPERATORS = {
+        "->", "++", "--", "<=", ">=", "==", "!=", "&&", "||",
+        "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<", ">>",
+        "<<=", ">>=", "+", "-", "*", "/", "%", "!", "&", "|", "^",
+        "~", "<", ">", "=", ".", "?", ":"
+    };
+
+    inline constexpr std::array<std::string_view, 12> PUNCTUATORS = {
+        "(", ")", "{", "}", "[", "]", ";", ",", ":", "...", "#", "##"
+    };
+
+    // 字面量的类别，可按位组合
+    enum PunctuationKind : uint8_t {
+        KIND_OPERATOR = 1,
+        KIND_PUNCTUATOR = 2,
+    };
+}
+
+// 编译期构建的字典树：所有字面量均为 ASCII 且不超过三个字节，最长匹配至多查表三次
+namespace c11::punctuation_trie {
+    inline constexpr size_t ALPHABET_SIZE = 128;
+    inline constexpr size_t MAX_NODES = 64;
+
+    struct Node {
+        std::array<uint8_t, ALPHABET_SIZE> next{}; // 子节点下标，0 表示无（根节点不会作为子节点）
+        uint8_t kinds = 0;                         // 以该节点结尾的字面量类别
+    };
+
+    struct Trie {
+        std::array<Node, MAX_NODES> nodes{};
+        size_t node_count = 1;
+        size_t max_length = 0;
+
+        constexpr void insert(const std::string_view literal, const uint8_t kind) {
+            size_t node = 0;
+            for (const char c: literal) {
+                const auto byte = static_cast<unsigned char>(c);
+                if (this->nodes[node].next[byte] == 0) {
+                    this->nodes[node].next[byte] = static_cast<uint8_t>(this->node_count++);
+                }
+                node = this->nodes[node].next[byte];
+            }
+            this->nodes[node].kinds |= kind;
+            if (literal.size() > this->max_length) this->max_length = literal.size();
+        }
+    };
+
+    // 节点数超过 MAX_NODES 时 insert 越界，常量求值失败，编译报错
+    constexpr Trie build() {
+        Trie trie;
+        for (const auto op: OPERATORS) trie.insert(op, KIND_OPERATOR);
+        for (const auto punc: PUNCTUATORS) trie.insert(punc, KIND_PUNCTUATOR);
+        return trie;
+    }
+
+    inline constexpr Trie TRIE = build();
+    static_assert(TRIE.node_count < MAX_NODES && TRIE.node_count <= UINT8_MAX, "enlarge MAX_NODES");
+    static_assert(TRIE.max_length <= 3, "literals are expected to be at most three bytes");
+}
+
+namespace c11 {
+    // 最长匹配：从 pos 开始沿字典树前进，返回类别属于 kinds 的最长字面量长度，0 表示无匹配
+    constexpr size_t longest_punctuation(const std::string_view input, const size_t pos, const uint8_t kinds) {
+        size_t node = 0;
+        size_t length = 0;
+        for (size_t i = pos; i < input.size(); ++i) {
+            const auto byte = static_cast<unsigned char>(input[i]);
+            if (byte >= punctuation_trie::ALPHABET_SIZE) break;
+            node = punctuation_trie::TRIE.nodes[node].next[byte];
+            if (node == 0) break;
+            if (punctuation_trie::TRIE.nodes[node].kinds & kinds) length = i - pos + 1;
+        }
+        return length;
+    }
+}
+
+#endif //POCOM_PUNCTUATION_HPP
@@ -5,16 +5,40 @@
 #ifndef POCOM_SCANNER_HPP
 #define POCOM_SCANNER_HPP
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
-#include <functional>
+#include <c11/lexer/source.hpp>
+#include <utils/arena.hpp>
 
+namespace lexer::regex {
+    class RuleLexer;
+}
+
+namespace utils {
+    class ThreadPool;
+}
 
 namespace c11 {
+    class TokenBuffer;
+
+    // 扫描模式
+    enum class ScanMode {
+        DFA,   // 使用 lexer::regex 编译的合并 DFA，单次线性扫描完成最长匹配（默认）
+        REGEX, // 使用 std::regex 按优先级逐个尝试匹配器，保留用于对比吞吐量
+    };
+
     // 词法错误类型枚举
     enum class ErrorType {
         INCOMPLETE_STRING,  // 未闭合的字符串，例如 "Hello
@@ -26,17 +50,20 @@ namespace c11 {
     };
 
     // 词法错误信息结构体，包含错误位置和描述
+    // message 指向 arena 中的文本，错误共享持有该 arena，从临时的扫描结果中拷贝出来后 message 仍然有效
     struct ScanError {
-        ErrorType type;      // 错误类型
-        std::string message; //错误描述
-        size_t line;         //错误行号
-        size_t column;       // 错误列号
+        ErrorType type;                            // 错误类型
+        std::string_view message;                  //错误描述
+        size_t line;                               //错误行号
+        size_t column;                             // 错误列号
+        size_t offset;                             // 错误处在源缓冲区中的字节偏移
+        std::shared_ptr<const utils::Arena> arena; // 错误描述所在的 arena
 
         ScanError() = delete;
 
-        explicit ScanError(const ErrorType type, std::string message, const size_t line,
-                           const size_t column) : type(type),
-                                                  message(std::move(message)), line(line), column(column) {}
+        explicit ScanError(const ErrorType type, const std::string_view message, const size_t line,
+                           const size_t column, const size_t offset, std::shared_ptr<const utils::Arena> arena)
+            : type(type), message(message), line(line), column(column), offset(offset), arena(std::move(arena)) {}
     };
 
     // Token 类型枚举
@@ -54,135 +81,254 @@ namespace c11 {
         TOK_WHITESPACE, // 空白符号
     };
 
-    // Token 结构体
+    // Token 结构体：value 指向 ScanResult 持有的源缓冲区，不单独分配内存
+    // Token 不保存行列号，需要时由 ScanResult::position 根据 value 在缓冲区中的偏移计算
     struct Token {
         TokenType type;
-        std::string value;
-        size_t line;
-        size_t column;
+        std::string_view value;
 
         Token() = delete;
 
-        explicit Token(const TokenType type, std::string value, const size_t line, const size_t column) : type(type),
-            value(std::move(value)), line(line), column(column) {}
+        explicit Token(const TokenType type, const std::string_view value) : type(type), value(value) {}
     };
 
-    // 扫描结果封装，Token 列表 + 错误列表
+    // 扫描结果封装，Token 列表 + 错误列表，同时持有 Token 所指向的源缓冲区
+    // 支持结构化绑定 auto [tokens, errors] = scanner.scan(code)，绑定期间源缓冲区随结果对象存活
     struct ScanResult {
-        std::vector<Token> tokens;     // 正常识别的 tokens
-        std::vector<ScanError> errors; // 收集的词法错误
+        std::vector<Token> tokens;                 // 正常识别的 tokens
+        std::vector<ScanError> errors;             // 收集的词法错误
+        std::shared_ptr<const SourceBuffer> source; // 源缓冲区，拷贝结果时共享而不复制
+        std::shared_ptr<utils::Arena> arena;        // 错误描述文本所在的单调分配器，出现第一个错误时创建，由各个错误共享持有
+
+        // Token 在源缓冲区中的字节偏移
+        [[nodiscard]] size_t offset(const Token &token) const {
+            return static_cast<size_t>(token.value.data() - this->source->view().data());
+        }
+
+        // Token 起始处的行列号，首次调用时构建源缓冲区的换行索引
+        [[nodiscard]] SourcePosition position(const Token &token) const {
+            return this->source->position(this->offset(token));
+        }
+
+        template<size_t I>
+        auto &get() & {
+            if constexpr (I == 0) return this->tokens;
+            else return this->errors;
+        }
+
+        template<size_t I>
+        const auto &get() const & {
+            if constexpr (I == 0) return this->tokens;
+            else return this->errors;
+        }
+
+        template<size_t I>
+        auto &&get() && {
+            if constexpr (I == 0) return std::move(this->tokens);
+            else return std::move(this->errors);
+        }
+    };
+
+    // 批量扫描中单个文件的结果
+    struct FileScanResult {
+        std::string path;    // 文件路径
+        ScanResult result;   // 扫描结果，文件无法读取时为空
+        std::string failure; // 打开或读取失败时的异常信息，成功时为空
+    };
+
+    // 单个匹配器（DFA 模式下为合并 DFA 中的单条规则）的热点统计
+    // DFA 模式每一步只命中一条规则，没有失败的尝试，attempts 与 hits 相同
+    struct MatcherStats {
+        std::string name;
+        uint64_t attempts = 0; // 尝试次数
+        uint64_t hits = 0;     // 成功次数
+        uint64_t bytes = 0;    // 成功时前进的字节数
+        uint64_t cycles = 0;   // 所有尝试（含失败）累计的时钟周期，x86 上为 TSC 计数，其他平台为纳秒
     };
 
     // Scanner
     class Scanner {
     private:
-        static const std::vector<std::string> keywords;    // 关键字
-        static const std::vector<std::string> operators;   // 运算符
-        static const std::vector<std::string> punctuators; // 标点符号
-        // 正则表达式模式，延迟初始化
+        // 扫描模式
+        ScanMode mode;
+        // 正则表达式模式，仅 REGEX 模式下初始化
         std::map<TokenType, std::regex> regex_patterns;
+        // 由 C11 Token 规则表生成的词法分析器（合并的最小 DFA），所有 Scanner 共享，只编译一次
+        const lexer::regex::RuleLexer *token_lexer = nullptr;
 
         void init_patterns();
-        static bool is_keyword(const std::string &str);
-        // 检查字符串/字符常量中的非法转义序列，返回错误信息
-        static std::optional<ScanError> check_escape_sequences(const std::string &literal,
-                                                               size_t start_line,
-                                                               size_t start_column);
+        static bool is_keyword(std::string_view str);
+        // 检查字符串/字符常量中的非法转义序列，发现错误时记录到结果中
+        static void check_escape_sequences(std::string_view literal, size_t start_offset, ScanResult &result);
         // 处理未闭合的多行注释
-        static void handle_unclosed_comment(const std::string &input, size_t &pos, size_t line, size_t column,
-                                            ScanResult &result);
+        static void handle_unclosed_comment(std::string_view input, size_t &pos, ScanResult &result);
+        // 记录词法错误：描述由多段文本直接拼接到结果的 arena 中，行列号由错误处的字节偏移计算
+        static void report_error(ScanResult &result, ErrorType type, std::initializer_list<std::string_view> message,
+                                 size_t offset);
+        static void report_error(ScanResult &result, ErrorType type, std::initializer_list<std::string_view> message,
+                                 size_t offset, SourcePosition position);
 
     private:
-        // 辅助函数，用于更新位置信息，用来处理换行/制表符
-        static void update_position(const std::string &matched_string, size_t &line, size_t &column);
         // 匹配注释
-        bool match_comments(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                            ScanResult &result) const;
+        bool match_comments(std::string_view input, size_t &pos, ScanResult &result) const;
         // 匹配字符串常量
-        static bool match_string(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                 ScanResult &result);
+        static bool match_string(std::string_view input, size_t &pos, ScanResult &result);
         // 匹配字符常量
-        static bool match_char(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                               ScanResult &result);
+        static bool match_char(std::string_view input, size_t &pos, ScanResult &result);
         // 匹配浮点常量
-        bool match_float(const std::string &input, size_t &pos, const size_t &line, const size_t &column,
-                         ScanResult &result) const;
+        bool match_float(std::string_view input, size_t &pos, ScanResult &result) const;
         // 匹配整数常量，含非法整数检测
-        bool match_integer(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                           ScanResult &result) const;
+        bool match_integer(std::string_view input, size_t &pos, ScanResult &result) const;
         // 匹配运算符
-        static bool match_operator(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                   ScanResult &result);
+        static bool match_operator(std::string_view input, size_t &pos, ScanResult &result);
         // 匹配标点符号
-        static bool match_punctuator(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                     ScanResult &result);
+        static bool match_punctuator(std::string_view input, size_t &pos, ScanResult &result);
         // 匹配标识符/关键字
-        bool match_identifier(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                              ScanResult &result) const;
+        bool match_identifier(std::string_view input, size_t &pos, ScanResult &result) const;
         // 匹配空白字符
-        bool match_whitespace(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                              ScanResult &result) const;
+        bool match_whitespace(std::string_view input, size_t &pos, ScanResult &result) const;
         // 处理无效字符
-        static void handle_invalid_char(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                        ScanResult &result);
+        static void handle_invalid_char(std::string_view input, size_t &pos, ScanResult &result);
+
+    private:
+        // 生成 Token 并前移扫描位置
+        static void emit_token(TokenType type, std::string_view input, size_t &pos, size_t length, ScanResult &result);
+        // DFA 模式：匹配单行注释，注释体一直延伸到换行符之前
+        static void match_line_comment(std::string_view input, size_t &pos, ScanResult &result);
+        // DFA 模式：匹配多行注释，含未闭合检测
+        static void match_block_comment(std::string_view input, size_t &pos, ScanResult &result);
+        // 两种模式共用：输出已匹配的整数常量，含非法八进制检测
+        static void emit_integer(std::string_view input, size_t &pos, size_t length, ScanResult &result);
+        // 拉取式 Token 流每次只调用 scan_range 扫描一个步骤
+        friend class TokenStream;
+        friend class ChunkedTokenStream;
+        // 从 pos 开始扫描，直到 Token 的起点不小于 end，返回停止位置，按照扫描模式分派
+        size_t scan_range(std::string_view input, size_t pos, size_t end, ScanResult &result) const;
+        // 两种扫描模式的实现
+        size_t scan_dfa(std::string_view input, size_t pos, size_t end, ScanResult &result) const;
+        size_t scan_regex(std::string_view input, size_t pos, size_t end, ScanResult &result) const;
 
     private:
-        // 定义匹配函数的签名：接收输入字符串、位置、行号、列号、扫描结果，返回是否匹配成功
-        using MatchFunc = std::function<bool(
-            const std::string &input, // 输入的源代码字符串
-            size_t &pos,              // 当前解析位置（引用，会被更新）
-            size_t &line,             // 当前行号（引用，会被更新）
-            size_t &column,           // 当前列号（引用，会被更新）
-            ScanResult &result        // 扫描结果（引用，用于存储Token和错误）
-        )>;
+        // 定义匹配函数的签名：接收扫描器、输入字符串、位置、扫描结果，返回是否匹配成功
+        // 使用普通函数指针而非 std::function，调用不经过类型擦除，扫描器移动后也不会持有悬空的 this
+        using MatchFunc = bool (*)(
+            const Scanner &scanner, // 当前扫描器
+            std::string_view input, // 输入的源代码字符串
+            size_t &pos,            // 当前解析位置（引用，会被更新）
+            ScanResult &result      // 扫描结果（引用，用于存储Token和错误）
+        );
 
         // 匹配结构体
         struct Matcher {
             MatchFunc func;
             std::string name;
+            std::string first_bytes; // 该匹配器可能成功时的首字节集合，用于构建首字节分派表
         };
 
-        // 原有的非静态成员函数版本（保持不变）
+        // 非静态成员函数版本
         template<auto Method>
-        Matcher make_matcher(std::string name) {
+        static Matcher make_matcher(std::string name, std::string first_bytes) {
             return {
-                [this](const std::string &input, size_t &pos, size_t &line, size_t &column, ScanResult &result) {
-                    // 非静态成员函数需要通过this调用
-                    return (this->*Method)(input, pos, line, column, result);
+                [](const Scanner &scanner, const std::string_view input, size_t &pos, ScanResult &result) {
+                    return (scanner.*Method)(input, pos, result);
                 },
-                std::move(name)
+                std::move(name), std::move(first_bytes)
             };
         }
 
-        // 新增：静态成员函数版本（无需捕获this）
+        // 静态成员函数版本
         template<auto StaticMethod>
-        [[nodiscard]] Matcher make_matcher_static(std::string name) const {
+        static Matcher make_matcher_static(std::string name, std::string first_bytes) {
             return {
-                [](const std::string &input, size_t &pos, size_t &line, size_t &column, ScanResult &result) {
-                    // 静态成员函数直接通过函数指针调用（无需this）
-                    return StaticMethod(input, pos, line, column, result);
+                [](const Scanner &, const std::string_view input, size_t &pos, ScanResult &result) {
+                    return StaticMethod(input, pos, result);
                 },
-                std::move(name)
+                std::move(name), std::move(first_bytes)
             };
         }
 
-        // 存储所有匹配器
+        // 存储所有匹配器，顺序即优先级
         std::vector<Matcher> matchers;
+        // 首字节分派表：首字节 b 的候选匹配器为 dispatch_candidates[dispatch_offsets[b], dispatch_offsets[b + 1])，
+        // 候选按优先级排列，没有候选的字节直接按无效字符处理
+        std::vector<uint8_t> dispatch_candidates;
+        std::array<uint16_t, 257> dispatch_offsets{};
+
+        // 由 matchers 的首字节集合构建分派表
+        void build_dispatch_table();
+
+        // 热点统计：每个匹配器（DFA 模式下每条规则）一组计数器，最后一组记录无效字符
+        // 扫描器在多个线程间共享，计数器以 relaxed 原子操作累加；未启用统计时不分配计数器
+        struct StatCounters {
+            std::atomic<uint64_t> attempts{0};
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> bytes{0};
+            std::atomic<uint64_t> cycles{0};
+        };
+
+        std::vector<std::string> stat_names;
+        std::unique_ptr<StatCounters[]> stat_counters;
+
+        void init_statistics();
+        // 累加一次尝试，未启用统计时为空操作
+        void record_stat(size_t slot, bool hit, size_t bytes, uint64_t cycles) const;
+        // 调用第 index 个匹配器，启用统计时记录尝试结果与耗时
+        bool try_matcher(size_t index, std::string_view input, size_t &pos, ScanResult &result) const;
 
     public:
-        Scanner();
+        explicit Scanner(ScanMode mode = ScanMode::DFA);
         ~Scanner() = default;
         // 禁止拷贝，但是允许移动
         Scanner(const Scanner &) = delete;
         Scanner &operator=(const Scanner &) = delete;
         Scanner(Scanner &&) = default;
         Scanner &operator=(Scanner &&) = default;
-        // 核心扫描接口：输入代码，返回 Token + 错误
-        [[nodiscard]] ScanResult scan(const std::string &input) const;
+        // 核心扫描接口：输入代码，返回 Token + 错误，输入移入结果持有的源缓冲区
+        [[nodiscard]] ScanResult scan(std::string input) const;
+        [[nodiscard]] ScanResult scan(std::shared_ptr<const SourceBuffer> source) const;
+        // 文件扫描接口：普通文件经 mmap 只读映射后直接扫描，管道/标准输入（路径为 "-"）回退为读入内存
+        [[nodiscard]] ScanResult scan_file(const std::string &path) const;
+        // 并行扫描接口：输入按 chunk_size 左右切分后在线程池上分块扫描，结果与 scan 逐项相同
+        // 块边界落在注释、字符串或多字符运算符内部时，在拼接阶段从真实位置重新同步，chunk_size 为 0 时抛出异常
+        [[nodiscard]] ScanResult scan_parallel(std::shared_ptr<const SourceBuffer> source, utils::ThreadPool &pool,
+                                               size_t chunk_size = 4 << 20) const;
+        // 结构数组输出接口：Token 的类型、偏移、长度（with_lines 时还有行号）分列存放，见 token_buffer.hpp
+        // 输入超过 4 GiB 时抛出 std::invalid_argument
+        [[nodiscard]] TokenBuffer scan_token_buffer(std::shared_ptr<const SourceBuffer> source,
+                                                    bool with_lines = false) const;
+        // 批量扫描接口：所有文件共享同一个只读扫描器，按文件大小从大到小提交到线程池，由工作窃取平衡负载
+        // 结果与 paths 一一对应，单个文件读取失败记录在 failure 中，不影响其他文件
+        [[nodiscard]] std::vector<FileScanResult> scan_files(const std::vector<std::string> &paths,
+                                                             utils::ThreadPool &pool) const;
+        [[nodiscard]] ScanMode scan_mode() const { return this->mode; }
+        // 一个扫描步骤越过其停止位置最多检查的字节数，由 C11 规则表的转移表计算，分块输入据此判断步骤是否最终
+        [[nodiscard]] static size_t max_lookahead();
+
+        // 热点统计在编译时由 CMake 选项 POCOM_SCANNER_STATS 启用，未启用时扫描路径上没有任何额外指令，
+        // 以下接口返回空结果；统计在扫描器的整个生命周期内累加，包括并行与批量扫描
+#ifdef POCOM_SCANNER_STATS
+        static constexpr bool STATS_ENABLED = true;
+#else
+        static constexpr bool STATS_ENABLED = false;
+#endif
+        // 按匹配器优先级（DFA 模式下按规则编号）排列的统计快照，最后一项为无效字符
+        [[nodiscard]] std::vector<MatcherStats> statistics() const;
+        void reset_statistics() const;
+        // 统计快照的文本表格，每行一个匹配器
+        [[nodiscard]] std::string dump_statistics() const;
         static std::string token_type_to_string(TokenType type);
         static std::string error_type_to_string(ErrorType type);
     };
 }
 
+// ScanResult 的结构化绑定：只绑定 tokens 与 errors
+template<>
+struct std::tuple_size<c11::ScanResult> : std::integral_constant<size_t, 2> {};
+
+template<size_t I>
+struct std::tuple_element<I, c11::ScanResult> {
+    using type = std::conditional_t<I == 0, std::vector<c11::Token>, std::vector<c11::ScanError> >;
+};
+
 
 #endif //POCOM_SCANNER_HPP
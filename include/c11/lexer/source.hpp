@@ -0,0 +1,61 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_SOURCE_HPP
+#define POCOM_SOURCE_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace c11 {
+    // 源码位置：行号与列号均从 1 开始，制表符占 4 列
+    struct SourcePosition {
+        size_t line;
+        size_t column;
+    };
+
+    // 只读源缓冲区：普通文件以 mmap 映射，其余输入（字符串、管道、标准输入）保存在内存中
+    // Token 以 string_view 指向缓冲区，缓冲区由 ScanResult 通过 shared_ptr 共享持有
+    class SourceBuffer {
+    public:
+        SourceBuffer(const SourceBuffer &) = delete;
+        SourceBuffer &operator=(const SourceBuffer &) = delete;
+        ~SourceBuffer();
+
+        // 由字符串构造，字符串移入缓冲区
+        static std::shared_ptr<const SourceBuffer> from_string(std::string text);
+        // 由外部内存构造，不复制内容：调用方保证 text 在缓冲区存活期间有效且不被修改
+        static std::shared_ptr<const SourceBuffer> from_view(std::string_view text);
+        // 由文件构造：普通文件 mmap 映射，管道等不可映射的输入回退为读入内存，路径为 "-" 时读取标准输入
+        // 打开或读取失败时抛出 std::runtime_error
+        static std::shared_ptr<const SourceBuffer> from_file(const std::string &path);
+
+        [[nodiscard]] std::string_view view() const { return {this->data, this->length}; }
+        [[nodiscard]] size_t size() const { return this->length; }
+        [[nodiscard]] bool is_mapped() const { return this->mapped; }
+        // 字节偏移对应的行列号：首次调用时一次性向量化扫描出所有换行符的位置，之后按行首偏移二分查找
+        // 扫描过程不再维护行列号，从不查询位置的调用方不承担任何开销，多线程并发查询是安全的
+        [[nodiscard]] SourcePosition position(size_t offset) const;
+        // 字节偏移所在的行号，只做二分查找，不计算列号
+        [[nodiscard]] size_t line(size_t offset) const;
+
+    private:
+        SourceBuffer() = default;
+        // 首次调用时构建换行索引
+        const std::vector<size_t> &line_index() const;
+
+        std::string owned;         // 未映射时的内容
+        const char *data = "";     // 内容起始地址，指向映射区域或 owned
+        size_t length = 0;         // 内容长度
+        bool mapped = false;       // 是否为 mmap 映射
+
+        mutable std::once_flag lines_built;      // 换行索引只构建一次
+        mutable std::vector<size_t> line_starts; // 每一行首字节的偏移，第 0 项为 0
+    };
+}
+
+#endif //POCOM_SOURCE_HPP
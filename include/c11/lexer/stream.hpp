@@ -0,0 +1,121 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_STREAM_HPP
+#define POCOM_STREAM_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <c11/lexer/scanner.hpp>
+#include <c11/lexer/source.hpp>
+
+// 1. 拉取式词法分析：每次调用 next_token 只向前扫描一个 Token，内存占用与输入大小无关
+namespace c11 {
+    // 对完整源缓冲区的拉取式 Token 流，结果与 Scanner::scan 的 Token 序列逐项相同
+    // 流只引用扫描器，扫描器必须比流存活更久；返回的 Token 指向源缓冲区，随流持有的缓冲区存活
+    class TokenStream {
+    public:
+        TokenStream(const Scanner &scanner, std::shared_ptr<const SourceBuffer> source);
+
+        // 下一个 Token，输入结束时返回 std::nullopt
+        std::optional<Token> next_token();
+        // 上一次调用 next_token 时新收集的错误，随产生它们的扫描步骤的第一个 Token 报告
+        [[nodiscard]] const std::vector<ScanError> &errors() const { return this->step.errors; }
+        // Token 在源缓冲区中的字节偏移与行列号
+        [[nodiscard]] size_t offset(const Token &token) const { return this->step.offset(token); }
+        [[nodiscard]] SourcePosition position(const Token &token) const { return this->step.position(token); }
+
+        // 单遍输入迭代器，支持 for (const Token &token: stream)
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Token;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Token *;
+            using reference = const Token &;
+
+            iterator() = default;
+            explicit iterator(TokenStream *stream) : stream(stream) { ++*this; }
+
+            reference operator*() const { return *this->current; }
+            pointer operator->() const { return &*this->current; }
+
+            iterator &operator++() {
+                this->current = this->stream->next_token();
+                if (!this->current) this->stream = nullptr;
+                return *this;
+            }
+
+            bool operator==(const iterator &other) const { return this->stream == other.stream; }
+            bool operator!=(const iterator &other) const { return this->stream != other.stream; }
+
+        private:
+            TokenStream *stream = nullptr;
+            std::optional<Token> current;
+        };
+
+        iterator begin() { return iterator(this); }
+        iterator end() { return {}; }
+
+    private:
+        const Scanner *scanner;
+        std::string_view input; // 源缓冲区内容
+        size_t pos = 0;         // 下一个扫描步骤的起点
+        ScanResult step;        // 当前扫描步骤的结果
+        size_t next = 0;        // step.tokens 中下一个待返回的 Token
+    };
+}
+
+// 2. 分块输入：数据从管道等来源陆续到达，只返回不会再被后续数据改变的 Token
+namespace c11 {
+    // 只有当扫描步骤停止位置之后的 lookahead 个字节都已到达，或输入已经结束时，步骤的结果才是最终的；
+    // 未闭合的注释、字符串会一直延伸到数据末尾，自然会等待更多数据。被撤销的步骤要等未消费的数据翻倍后
+    // 才重试，长时间未闭合的注释总共只会被重新扫描对数次。已返回的 Token 之前的数据在下一次 feed 时
+    // 从缓冲区前端移除，内存只与尚未消费的数据量有关
+    class ChunkedTokenStream {
+    public:
+        // 规则表的读取没有上界时抛出 std::logic_error
+        explicit ChunkedTokenStream(const Scanner &scanner);
+
+        // 追加到达的数据，之前返回的 Token 与尚未取走的错误随之失效
+        void feed(std::string_view data);
+        // 标记输入结束，剩余数据全部可以扫描
+        void finish();
+        // 下一个完整的 Token，需要更多数据或输入已结束时返回 std::nullopt，由 exhausted 区分
+        std::optional<Token> next_token();
+        // 输入已结束且所有 Token 都已返回
+        [[nodiscard]] bool exhausted() const;
+        // 上一次调用 next_token 时新收集的错误，行列号与偏移均相对整个输入
+        [[nodiscard]] const std::vector<ScanError> &errors() const { return this->step.errors; }
+        // Token 在整个输入中的字节偏移
+        [[nodiscard]] size_t offset(const Token &token) const {
+            return this->base_offset + this->step.offset(token);
+        }
+        // 开销观测：被撤销、等待更多数据的扫描步骤数，尚未消费的字节数与缓冲区容量
+        [[nodiscard]] size_t rescans() const { return this->undone_steps; }
+        [[nodiscard]] size_t buffered() const { return this->text.size() - this->pos; }
+        [[nodiscard]] size_t capacity() const { return this->text.capacity(); }
+
+    private:
+        const Scanner *scanner;
+        size_t lookahead;                           // 扫描步骤越过停止位置最多检查的字节数，例如 1.5e+x 为 3
+        std::string text;                           // 尚未消费的数据，原地压缩后追加新数据
+        std::shared_ptr<const SourceBuffer> window; // text 的只读视图，每次 feed 后重建
+        size_t pos = 0;                             // 下一个扫描步骤在 window 中的起点
+        size_t retry_size = 0;                      // 被撤销的步骤在 window 增长到该大小之前不重试
+        size_t undone_steps = 0;                    // 累计撤销的步骤数
+        size_t base_offset = 0;                     // window 起点在整个输入中的偏移
+        SourcePosition base_position{1, 1};         // window 起点在整个输入中的行列号
+        bool finished = false;
+        ScanResult step;
+        size_t next = 0;
+    };
+}
+
+#endif //POCOM_STREAM_HPP
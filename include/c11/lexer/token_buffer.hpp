@@ -0,0 +1,117 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_TOKEN_BUFFER_HPP
+#define POCOM_TOKEN_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <c11/lexer/scanner.hpp>
+#include <c11/lexer/source.hpp>
+
+namespace c11 {
+    class TokenBuffer;
+
+    // TokenBuffer 中单个 Token 的轻量代理：只保存缓冲区指针与下标，按需读取各列
+    class TokenRef {
+    public:
+        TokenRef(const TokenBuffer &buffer, const size_t index) : buffer(&buffer), index(index) {}
+
+        [[nodiscard]] TokenType type() const;
+        [[nodiscard]] uint32_t offset() const;
+        [[nodiscard]] uint32_t length() const;
+        [[nodiscard]] std::string_view value() const;
+        // 行号，仅在扫描时要求记录行号时可用
+        [[nodiscard]] uint32_t line() const;
+        // 转换为数组结构的 Token
+        [[nodiscard]] Token to_token() const { return Token(type(), value()); }
+
+    private:
+        const TokenBuffer *buffer;
+        size_t index;
+    };
+
+    // 结构数组（SoA）形式的扫描结果：类型、偏移、长度（以及可选的行号）各自连续存放
+    // 只关心 Token 类型的遍历（计数、括号匹配、关键字统计）只需读取每个 Token 1 字节，
+    // 也便于对类型数组做向量化处理；偏移与长度为 32 位，输入不能超过 4 GiB
+    class TokenBuffer {
+    public:
+        explicit TokenBuffer(std::shared_ptr<const SourceBuffer> source, bool with_lines = false);
+
+        // 追加一个 Token，value 必须指向源缓冲区
+        void push_back(const Token &token);
+        void reserve(size_t count);
+
+        [[nodiscard]] size_t size() const { return this->kind_column.size(); }
+        [[nodiscard]] bool empty() const { return this->kind_column.empty(); }
+        [[nodiscard]] bool has_lines() const { return this->with_lines; }
+
+        // 各列的连续数组，类型列为 TokenType 的取值
+        [[nodiscard]] const std::vector<uint8_t> &kinds() const { return this->kind_column; }
+        [[nodiscard]] const std::vector<uint32_t> &offsets() const { return this->offset_column; }
+        [[nodiscard]] const std::vector<uint32_t> &lengths() const { return this->length_column; }
+        [[nodiscard]] const std::vector<uint32_t> &lines() const { return this->line_column; }
+
+        [[nodiscard]] const std::vector<ScanError> &errors() const { return this->error_list; }
+        [[nodiscard]] std::vector<ScanError> &errors() { return this->error_list; }
+        [[nodiscard]] const std::shared_ptr<const SourceBuffer> &source() const { return this->source_buffer; }
+
+        [[nodiscard]] TokenRef operator[](const size_t index) const { return {*this, index}; }
+
+        // 按下标遍历的迭代器，解引用得到 TokenRef
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = TokenRef;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = TokenRef;
+
+            iterator(const TokenBuffer &buffer, const size_t index) : buffer(&buffer), index(index) {}
+
+            TokenRef operator*() const { return {*this->buffer, this->index}; }
+
+            iterator &operator++() {
+                ++this->index;
+                return *this;
+            }
+
+            bool operator==(const iterator &other) const { return this->index == other.index; }
+            bool operator!=(const iterator &other) const { return this->index != other.index; }
+
+        private:
+            const TokenBuffer *buffer;
+            size_t index;
+        };
+
+        [[nodiscard]] iterator begin() const { return {*this, 0}; }
+        [[nodiscard]] iterator end() const { return {*this, size()}; }
+
+    private:
+        std::shared_ptr<const SourceBuffer> source_buffer;
+        bool with_lines;
+        std::vector<uint8_t> kind_column;
+        std::vector<uint32_t> offset_column;
+        std::vector<uint32_t> length_column;
+        std::vector<uint32_t> line_column;
+        std::vector<ScanError> error_list;
+
+        friend class TokenRef;
+    };
+
+    inline TokenType TokenRef::type() const { return static_cast<TokenType>(this->buffer->kind_column[this->index]); }
+    inline uint32_t TokenRef::offset() const { return this->buffer->offset_column[this->index]; }
+    inline uint32_t TokenRef::length() const { return this->buffer->length_column[this->index]; }
+    inline uint32_t TokenRef::line() const { return this->buffer->line_column[this->index]; }
+
+    inline std::string_view TokenRef::value() const {
+        return this->buffer->source_buffer->view().substr(offset(), length());
+    }
+}
+
+#endif //POCOM_TOKEN_BUFFER_HPP
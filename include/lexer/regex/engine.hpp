@@ -5,50 +5,60 @@
 #ifndef POCOM_ENGINE_HPP
 #define POCOM_ENGINE_HPP
 
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <memory>
+#include <algorithm>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <string>
 
-// 全局常量部分
+// 全局类型部分
 namespace lexer::regex {
-    // 全局常量：表示 ε 转移，代替 '\0'，提升可读性
-    constexpr char EPSILON = '\0';
+    // 字节集合：字符类、. 以及单个字符统一表示为 256 位的集合，第 b 位表示字节 b
+    using CharSet = std::bitset<256>;
 }
 
 // 1. 词法单元定义
 namespace lexer::regex {
     enum class TokenType {
-        CHAR,   // 普通字符
-        STAR,   // * 闭包
-        OR,     // | 选择
-        LPAREN, // ( 左括号
-        RPAREN, // ) 又括号
-        CONCAT, // 隐含连接符，仅供内部使用
+        CHAR,     // 字节集合：普通字符、字符类 [...] 或 .
+        STAR,     // * 闭包
+        OR,       // | 选择
+        LPAREN,   // ( 左括号
+        RPAREN,   // ) 又括号
+        CONCAT,   // 隐含连接符，仅供内部使用
+        PLUS,     // + 正闭包
+        QUESTION, // ? 可选
     };
 
     struct Token {
         TokenType type;
-        char value; // 仅 CHAR 类型有效（经过转义后的值）
+        CharSet chars; // 仅 CHAR 类型有效，可匹配的字节集合
     };
 }
 
 // 2. NFA 相关定义
 namespace lexer::regex {
+    // Thompson 构造保证每个状态至多一条带标签的边和两条 ε 边，状态以下标存放在 NFA 的连续数组中
     struct NFAState {
-        bool is_accept;
-        const int id;
-        std::unordered_map<char, std::vector<NFAState *> > transitions;
+        static constexpr int NONE = -1;
 
-        explicit NFAState(bool is_accept);
+        bool is_accept = false;
+        int rule = -1;                   // 接受状态对应的规则编号，-1 表示不属于任何规则
+        CharSet label;                   // 带标签边上的字节集合，仅当 out 有效时有意义
+        int out = NONE;                  // 带标签边的目标状态
+        int epsilon[2] = {NONE, NONE};   // ε 边的目标状态
+
+        [[nodiscard]] bool has_label() const { return this->out != NONE; }
     };
 
     class NFA {
     public:
-        NFAState *start = nullptr;
-        NFAState *end = nullptr;
-        std::vector<std::unique_ptr<NFAState> > states;
+        int start = NFAState::NONE;
+        int end = NFAState::NONE;
+        std::vector<NFAState> states; // 状态竞技场，下标即状态编号
 
     public:
         NFA() = default;
@@ -57,30 +67,85 @@ namespace lexer::regex {
         NFA(NFA &&) = default;
         NFA &operator=(NFA &&) = default;
 
-        // 添加状态并返回原始指针，所有权保留在 NFA 中
-        NFAState *add_state(std::unique_ptr<NFAState> state);
+        // 添加状态并返回其下标
+        int add_state(bool is_accept = false);
+        // 添加带标签的边，每个状态至多一条
+        void add_transition(int from, const CharSet &label, int to);
+        // 添加 ε 边，每个状态至多两条
+        void add_epsilon(int from, int to);
         // 调试用：打印 NFA 结构
         void print(const std::string &name = "NFA") const;
     };
 }
 
-// NFAState* 的 hash 函数，用于加入到 unordered_set 里面
-template<>
-struct std::hash<std::unordered_set<lexer::regex::NFAState *> > {
-    size_t operator()(const std::unordered_set<lexer::regex::NFAState *> &state_set) const noexcept {
-        size_t hash_value = 0;
-        for (const auto *state: state_set) {
-            hash_value ^= std::hash<int>()(state->id);
+// NFA 状态集合
+namespace lexer::regex {
+    // 子集构造使用的 NFA 状态集合：按状态下标存储的稠密位集
+    class StateSet {
+    public:
+        std::vector<uint64_t> words;
+
+    public:
+        StateSet() = default;
+        explicit StateSet(const size_t state_count) : words((state_count + 63) / 64, 0) {}
+
+        void insert(const size_t index) { this->words[index >> 6] |= uint64_t{1} << (index & 63); }
+
+        [[nodiscard]] bool contains(const size_t index) const {
+            return (this->words[index >> 6] >> (index & 63)) & 1;
+        }
+
+        [[nodiscard]] bool empty() const {
+            for (const uint64_t w: this->words) {
+                if (w) return false;
+            }
+            return true;
+        }
+
+        void clear() { std::fill(this->words.begin(), this->words.end(), 0); }
+
+        // 按下标升序遍历集合中的状态
+        template<typename Func>
+        void for_each(Func &&func) const {
+            for (size_t i = 0; i < this->words.size(); ++i) {
+                for (uint64_t w = this->words[i]; w; w &= w - 1) {
+                    func(i * 64 + static_cast<size_t>(__builtin_ctzll(w)));
+                }
+            }
         }
-        return hash_value;
-    }
-};
+
+        bool operator==(const StateSet &other) const { return this->words == other.words; }
+    };
+
+    // StateSet 的 hash 函数：逐字混合（splitmix64 终结函数），避免异或哈希的大量碰撞
+    struct StateSetHash {
+        size_t operator()(const StateSet &set) const noexcept {
+            uint64_t hash = 0x9e3779b97f4a7c15ULL ^ set.words.size();
+            for (const uint64_t w: set.words) {
+                uint64_t z = hash + w + 0x9e3779b97f4a7c15ULL;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                hash = z ^ (z >> 31);
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+}
 
 // 3. DFA 相关定义
 namespace lexer::regex {
+    // 字节等价类：在所有状态上转移目标都相同的字节归为一类，类编号按首次出现的字节顺序分配
+    struct ByteClasses {
+        std::array<uint8_t, 256> map{}; // 字节 -> 等价类编号
+        uint16_t count = 1;             // 等价类数量
+
+        [[nodiscard]] uint8_t of(const char c) const { return this->map[static_cast<unsigned char>(c)]; }
+    };
+
     struct DFAState {
         bool is_accept;
         const int id;
+        int rule = -1; // 接受状态对应的最高优先级规则编号（编号越小优先级越高），-1 表示无
         std::unordered_map<char, DFAState *> transitions;
 
         explicit DFAState(bool is_accept);
@@ -90,7 +155,7 @@ namespace lexer::regex {
     public:
         DFAState *start = nullptr;
         std::vector<std::unique_ptr<DFAState> > states;
-        std::unordered_map<std::unordered_set<NFAState *>, DFAState *> state_map;
+        ByteClasses byte_classes; // 整个自动机的字节等价类，由 build_dfa/minimize_dfa 计算
 
     public:
         DFA() = default;
@@ -106,23 +171,115 @@ namespace lexer::regex {
     };
 }
 
-// 4.核心功能函数的声明
+// 4. 冻结的稠密 DFA 定义
+namespace lexer::regex {
+    // 由 DFA 扁平化得到的只读转移表：next[state * 256 + byte] 即下一状态，每个字节只需一次查表
+    class DenseDFA {
+    public:
+        // 0 号状态为死状态，所有缺失的转移都指向它，匹配时遇到即可停止
+        static constexpr uint32_t DEAD_STATE = 0;
+        static constexpr size_t ALPHABET_SIZE = 256;
+
+        uint32_t start = DEAD_STATE;
+        uint32_t state_count = 0;
+        std::vector<uint32_t> next;   // state_count * 256 的转移表
+        std::vector<uint64_t> accept; // 接受状态位图
+        std::vector<int> rules;       // 每个状态的规则编号，-1 表示无
+
+    public:
+        [[nodiscard]] bool is_accept(const uint32_t state) const {
+            return (this->accept[state >> 6] >> (state & 63)) & 1;
+        }
+
+        [[nodiscard]] uint32_t step(const uint32_t state, const char c) const {
+            return this->next[state * ALPHABET_SIZE + static_cast<unsigned char>(c)];
+        }
+    };
+}
+
+// 5. 按字节等价类压缩的 DFA 定义
+namespace lexer::regex {
+    // 压缩转移表：先经 256 项的类映射，再查 state_count * class_count 的表，状态 0 为死状态
+    class CompactDFA {
+    public:
+        static constexpr uint16_t DEAD_STATE = 0;
+        // uint16_t 状态编号可表示的最大状态数（含死状态）
+        static constexpr size_t MAX_STATES = 65536;
+
+        ByteClasses classes;
+        uint16_t start = DEAD_STATE;
+        uint32_t state_count = 0;
+        std::vector<uint16_t> next;   // state_count * classes.count 的转移表
+        std::vector<uint64_t> accept; // 接受状态位图
+        std::vector<int> rules;       // 每个状态的规则编号，-1 表示无
+
+    public:
+        [[nodiscard]] bool is_accept(const uint16_t state) const {
+            return (this->accept[state >> 6] >> (state & 63)) & 1;
+        }
+
+        [[nodiscard]] uint16_t step(const uint16_t state, const char c) const {
+            return this->next[static_cast<size_t>(state) * this->classes.count + this->classes.of(c)];
+        }
+
+        // 转移表与类映射占用的字节数
+        [[nodiscard]] size_t table_bytes() const {
+            return this->next.size() * sizeof(uint16_t) + sizeof(this->classes.map);
+        }
+    };
+}
+
+// 6. 匹配结果定义
+namespace lexer::regex {
+    // 最长前缀匹配的结果：匹配长度 + 命中的规则编号
+    struct PrefixMatch {
+        size_t length = 0; // 最长接受前缀的长度，0 表示没有匹配
+        int rule = -1;     // 该前缀对应的规则编号，-1 表示没有匹配
+    };
+}
+
+// 7.核心功能函数的声明
 namespace lexer::regex {
-    // 预处理：处理正则表达式中的转义字符，例如 \. -> .
+    // 预处理：处理正则表达式中的转义字符，例如 \a -> a，元字符的转义保留
     std::string preprocess_regex(const std::string_view &raw_regex);
-    // 词法分析：预处理后的正则 -> Token 列表
+    // 词法分析：预处理后的正则 -> Token 列表，字符类与 . 折叠为一个 CHAR，{m,n} 在此展开
     std::vector<Token> lexer(std::string_view processed_regex);
     // 语法分析：Token 列表 -> 后缀表达式
-    std::string infix_to_postfix(const std::vector<Token> &tokens);
+    std::vector<Token> infix_to_postfix(const std::vector<Token> &tokens);
     // NFA 构建：后缀表达式 -> NFA
-    std::unique_ptr<NFA> build_nfa(const std::string &postfix);
+    std::unique_ptr<NFA> build_nfa(const std::vector<Token> &postfix);
+    // 完整前端：原始正则 -> NFA（预处理、词法分析、后缀转换、NFA 构建）
+    std::unique_ptr<NFA> regex_to_nfa(std::string_view raw_regex);
+    // 多规则合并：第 i 个 NFA 的接受状态标记为规则 i，编号越小优先级越高
+    std::unique_ptr<NFA> combine_rules(std::vector<std::unique_ptr<NFA> > &&rules);
+    // ε 闭包：为每个 NFA 状态预先计算 ε 闭包，结果为有序的状态下标列表
+    std::vector<std::vector<uint32_t> > epsilon_closures(const NFA &nfa);
+    // 字节等价类：按 NFA 所有带标签边细分 256 个字节，同一类的字节在任何状态上行为相同
+    ByteClasses compute_byte_classes(const NFA &nfa);
     // DFA 构建: NFA -> DFA ，NFA 所有权转移到 DFA
-    std::unique_ptr<DFA> build_dfa(const std::unique_ptr<NFA> &nfa);
+    // rule_sets 非空时按 dfa->states 的下标输出每个状态接受的全部规则编号（位集），供多模式匹配使用
+    std::unique_ptr<DFA> build_dfa(const std::unique_ptr<NFA> &nfa, std::vector<StateSet> *rule_sets = nullptr);
     // DFA 最小化：原始 DFA -> 最小 DFA
     std::unique_ptr<DFA> minimize_dfa(const DFA &original_dfa);
     // 匹配：最小 DFA + 输入字符串 -> 是否完全匹配
     bool match(const DFA &dfa, std::string_view input);
-    // 工具函数：重置状态 ID 计数器，用于多次测试/构建
+    // 最长匹配：从 pos 开始沿 DFA 前进，返回最长的接受前缀（maximal munch）
+    PrefixMatch longest_match(const DFA &dfa, std::string_view input, size_t pos);
+    // 冻结：DFA -> 稠密转移表，状态按原 DFA 的顺序编号（从 1 开始）
+    DenseDFA freeze_dfa(const DFA &dfa);
+    // 匹配：稠密转移表 + 输入字符串 -> 是否完全匹配
+    bool match(const DenseDFA &dfa, std::string_view input);
+    // 最长匹配：稠密转移表版本
+    PrefixMatch longest_match(const DenseDFA &dfa, std::string_view input, size_t pos);
+    // 字节等价类：遍历所有状态的转移，逐步细分 256 个字节
+    ByteClasses compute_byte_classes(const DFA &dfa);
+    // 压缩：DFA -> 按字节等价类压缩的转移表，字节类由 DFA 的转移重新计算，状态数超过 CompactDFA::MAX_STATES 时抛出异常
+    CompactDFA compress_dfa(const DFA &dfa);
+    // 匹配：压缩转移表 + 输入字符串 -> 是否完全匹配
+    bool match(const CompactDFA &dfa, std::string_view input);
+    // 最长匹配：压缩转移表版本
+    PrefixMatch longest_match(const CompactDFA &dfa, std::string_view input, size_t pos);
+    // 工具函数：重置 DFA 状态 ID 计数器，用于多次测试/构建
     void reset_state_counters();
 }
 
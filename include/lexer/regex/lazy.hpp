@@ -0,0 +1,82 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_LAZY_HPP
+#define POCOM_LAZY_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <lexer/regex/engine.hpp>
+
+namespace lexer::regex {
+    // 惰性 DFA：直接在 NFA 上模拟，只有输入真正到达的 DFA 状态才被构造并缓存
+    // 缓存超过内存预算时整体清空，保证内存可控；匹配会修改缓存，因此不是线程安全的
+    class LazyDFA {
+    public:
+        static constexpr size_t DEFAULT_MEMORY_BUDGET = 1 << 20; // 默认缓存预算 1 MB
+
+    private:
+        static constexpr uint32_t DEAD_STATE = 0;       // 空状态集合
+        static constexpr uint32_t UNKNOWN = UINT32_MAX; // 尚未计算的转移
+
+        // 缓存中的 DFA 状态
+        struct CachedState {
+            StateSet set;
+            bool is_accept;
+            int rule;
+        };
+
+        std::unique_ptr<NFA> nfa;
+        std::vector<std::vector<uint32_t> > closures; // 每个 NFA 状态的 ε 闭包
+        ByteClasses classes;                          // NFA 的字节等价类
+        StateSet start_set;                           // 起始状态集合，清空缓存后用于重建
+
+        std::vector<CachedState> states;                               // 已构造的 DFA 状态
+        std::vector<uint32_t> next;                                    // states * classes 的转移缓存
+        std::unordered_map<StateSet, uint32_t, StateSetHash> state_map; // 状态集合 -> 缓存下标
+        uint32_t start = DEAD_STATE;
+
+        size_t memory_budget;
+        size_t memory_usage = 0;
+        size_t flushes = 0;
+
+    public:
+        explicit LazyDFA(std::unique_ptr<NFA> nfa, size_t memory_budget = DEFAULT_MEMORY_BUDGET);
+        LazyDFA(const LazyDFA &) = delete;
+        LazyDFA &operator=(const LazyDFA &) = delete;
+        LazyDFA(LazyDFA &&) = default;
+        LazyDFA &operator=(LazyDFA &&) = default;
+
+        // 匹配：输入字符串 -> 是否完全匹配
+        bool match(std::string_view input);
+        // 最长匹配：从 pos 开始的最长接受前缀
+        PrefixMatch longest_match(std::string_view input, size_t pos);
+
+        // 当前缓存的 DFA 状态数量（含死状态）
+        [[nodiscard]] size_t cached_states() const { return this->states.size(); }
+        // 当前缓存占用的估算字节数
+        [[nodiscard]] size_t cache_bytes() const { return this->memory_usage; }
+        // 缓存被清空的次数
+        [[nodiscard]] size_t flush_count() const { return this->flushes; }
+
+    private:
+        // 查找或构造状态集合对应的缓存状态
+        uint32_t find_or_add(StateSet &&set);
+        // 计算 state 在字节类 cls 上的转移，必要时清空缓存，返回值在清空后依然有效
+        uint32_t compute_transition(uint32_t state, uint8_t cls);
+        // 清空缓存，只保留死状态与起始状态
+        void reset_cache();
+        // 单步转移：命中缓存时只需一次查表
+        uint32_t step(const uint32_t state, const char c) {
+            const uint8_t cls = this->classes.of(c);
+            const uint32_t target = this->next[static_cast<size_t>(state) * this->classes.count + cls];
+            return target != UNKNOWN ? target : compute_transition(state, cls);
+        }
+    };
+}
+
+#endif //POCOM_LAZY_HPP
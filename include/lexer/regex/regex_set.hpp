@@ -0,0 +1,51 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_REGEX_SET_HPP
+#define POCOM_REGEX_SET_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <lexer/regex/engine.hpp>
+
+namespace lexer::regex {
+    // 多模式正则集合：N 个模式合并为一个 DFA，每个接受状态附带命中模式编号的位集，
+    // 扫描一遍输入即可得到所有完全匹配的模式，每字节一次查表，吞吐量与模式数量无关
+    // 不同接受状态的模式集合不同，合并后的 DFA 不做最小化（minimize_dfa 只区分最高优先级的规则）
+    class RegexSet {
+    public:
+        static constexpr uint32_t DEAD_STATE = 0;
+
+        // 按顺序编译模式，模式编号即下标；模式列表为空或模式非法时抛出 std::invalid_argument
+        explicit RegexSet(const std::vector<std::string> &patterns);
+
+        // 完全匹配 input 的所有模式编号，升序排列
+        [[nodiscard]] std::vector<size_t> matches(std::string_view input) const;
+        // 是否至少有一个模式完全匹配 input
+        [[nodiscard]] bool is_match(std::string_view input) const;
+
+        // 模式数量
+        [[nodiscard]] size_t size() const { return this->pattern_count; }
+        // 合并 DFA 的状态数量（含死状态）
+        [[nodiscard]] size_t state_count() const { return this->next.size() / this->classes.count; }
+
+    private:
+        size_t pattern_count;
+        size_t words = 0;                 // 每个状态的模式位集占用的 64 位字数
+        ByteClasses classes;              // 合并 DFA 的字节等价类
+        uint32_t start = DEAD_STATE;
+        std::vector<uint32_t> next;       // state_count * classes.count 的转移表
+        std::vector<uint64_t> match_sets; // state_count * words 的模式位集，非接受状态全为 0
+
+        // 沿转移表走完整个输入，返回最终状态，进入死状态时提前结束
+        [[nodiscard]] uint32_t run(std::string_view input) const;
+        [[nodiscard]] const uint64_t *match_set(const uint32_t state) const {
+            return this->match_sets.data() + static_cast<size_t>(state) * this->words;
+        }
+    };
+}
+
+#endif //POCOM_REGEX_SET_HPP
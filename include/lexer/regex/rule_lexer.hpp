@@ -0,0 +1,55 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_RULE_LEXER_HPP
+#define POCOM_RULE_LEXER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <lexer/regex/engine.hpp>
+
+namespace lexer::regex {
+    // 词法规则：正则表达式 + Token 种类，种类由使用者定义（通常是某个语言的枚举值）
+    struct LexRule {
+        std::string regex;
+        int kind;
+    };
+
+    // 一次最长匹配的结果
+    struct LexMatch {
+        size_t length = 0; // Token 长度，0 表示没有规则匹配
+        int rule = -1;     // 命中规则在规则表中的下标
+        int kind = -1;     // 命中规则的 Token 种类
+    };
+
+    // 词法分析器生成器：按优先级排列的规则表编译为一个合并的最小 DFA，接受状态记录优先级最高的规则
+    // next_token 按最长匹配（maximal munch）识别一个 Token，长度相同时取规则表中靠前的规则
+    // 构造后只读，可在多个线程间共享；规则表为空、正则非法或状态数超过 CompactDFA::MAX_STATES 时抛出异常
+    class RuleLexer {
+    public:
+        // max_lookahead 没有上界时的取值
+        static constexpr size_t UNBOUNDED = static_cast<size_t>(-1);
+
+        explicit RuleLexer(std::vector<LexRule> rules);
+
+        // 从 pos 开始识别一个 Token，只能匹配空串的规则不会产生 Token
+        [[nodiscard]] LexMatch next_token(std::string_view buffer, size_t pos) const;
+
+        [[nodiscard]] const std::vector<LexRule> &rules() const { return this->rule_table; }
+        // 合并后的压缩转移表
+        [[nodiscard]] const CompactDFA &dfa() const { return this->token_dfa; }
+        // next_token 越过 Token 末尾最多读取的字节数（由起始状态出发且没有匹配时越过起点读取的字节数也不超过它）
+        // 由转移表计算：接受状态之后只经过非接受状态的最长路径，非接受状态之间有环时为 UNBOUNDED
+        [[nodiscard]] size_t max_lookahead() const { return this->lookahead; }
+
+    private:
+        std::vector<LexRule> rule_table;
+        CompactDFA token_dfa;
+        size_t lookahead = 0;
+    };
+}
+
+#endif //POCOM_RULE_LEXER_HPP
@@ -0,0 +1,66 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_SKIP_HPP
+#define POCOM_SKIP_HPP
+
+#include <cstddef>
+#include <string_view>
+
+// 1. 指令集与内核表定义
+namespace lexer::simd {
+    // 跳过内核使用的指令集，按能力从低到高排列
+    enum class Isa {
+        SCALAR, // 逐字节的标量实现，所有平台可用
+        SSE2,   // 每次处理 16 字节，x86-64 的基线指令集
+        AVX2,   // 每次处理 32 字节，运行时检测 CPU 支持后启用
+    };
+
+    // 跳过内核：每个函数从 pos 开始查找，返回 [pos, size) 中第一个满足条件的下标，不存在时返回 size
+    struct SkipKernels {
+        Isa isa;
+        // 第一个不属于空白字符 [ \t\n\r\f] 的字节
+        size_t (*skip_whitespace)(const char *data, size_t size, size_t pos);
+        // 第一个不属于标识符字符 [a-zA-Z0-9_] 的字节
+        size_t (*skip_identifier)(const char *data, size_t size, size_t pos);
+        // 第一个等于 target 的字节，用于行尾、引号等单字节查找
+        size_t (*find_byte)(const char *data, size_t size, size_t pos, char target);
+        // 第一个 "*/" 的起始下标，用于多行注释
+        size_t (*find_comment_end)(const char *data, size_t size, size_t pos);
+        // 第一个未被反斜杠转义的 quote，用于字符串与字符常量的闭合引号
+        size_t (*find_quote_end)(const char *data, size_t size, size_t pos, char quote);
+    };
+}
+
+// 2. 运行时分派
+namespace lexer::simd {
+    // 当前 CPU 支持的最高指令集
+    Isa detect_isa();
+    // 指定指令集的内核表，当前 CPU 或编译器不支持时回退到可用的最高指令集
+    const SkipKernels &kernels_for(Isa isa);
+    // 当前 CPU 的内核表，首次调用时检测一次
+    const SkipKernels &kernels();
+
+    inline size_t skip_whitespace(const std::string_view input, const size_t pos) {
+        return kernels().skip_whitespace(input.data(), input.size(), pos);
+    }
+
+    inline size_t skip_identifier(const std::string_view input, const size_t pos) {
+        return kernels().skip_identifier(input.data(), input.size(), pos);
+    }
+
+    inline size_t find_byte(const std::string_view input, const size_t pos, const char target) {
+        return kernels().find_byte(input.data(), input.size(), pos, target);
+    }
+
+    inline size_t find_comment_end(const std::string_view input, const size_t pos) {
+        return kernels().find_comment_end(input.data(), input.size(), pos);
+    }
+
+    inline size_t find_quote_end(const std::string_view input, const size_t pos, const char quote) {
+        return kernels().find_quote_end(input.data(), input.size(), pos, quote);
+    }
+}
+
+#endif //POCOM_SKIP_HPP
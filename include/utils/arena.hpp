@@ -0,0 +1,45 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_ARENA_HPP
+#define POCOM_ARENA_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace utils {
+    // 单调文本分配器：按块向系统申请内存，分配只移动游标，不单独释放，所有内存随 Arena 析构一次性释放
+    // 已分配的地址在 Arena 存活期间始终有效，不是线程安全的
+    class Arena {
+    public:
+        // first_block 为第一个内存块的大小，之后每块翻倍，直到 MAX_BLOCK
+        explicit Arena(size_t first_block = 4096);
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        static constexpr size_t MAX_BLOCK = 1 << 20;
+
+        // 分配 size 字节的未初始化内存
+        char *allocate(size_t size);
+        // 复制文本到 Arena
+        std::string_view store(std::string_view text);
+        // 拼接多段文本，直接写入 Arena，不经过临时 std::string
+        std::string_view concat(std::initializer_list<std::string_view> parts);
+
+        // 已分配的字节数
+        [[nodiscard]] size_t used() const { return this->used_bytes; }
+
+    private:
+        std::vector<std::unique_ptr<char[]> > blocks;
+        char *cursor = nullptr;  // 当前块中下一个可用字节
+        size_t remaining = 0;    // 当前块剩余字节数
+        size_t next_block;       // 下一个内存块的大小
+        size_t used_bytes = 0;
+    };
+}
+
+#endif //POCOM_ARENA_HPP
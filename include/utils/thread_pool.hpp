@@ -0,0 +1,69 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_THREAD_POOL_HPP
+#define POCOM_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+    // 工作窃取线程池：每个工作线程有自己的双端队列
+    // 外部提交的任务轮流放入各队列，工作线程内部提交的任务放入自己的队列；
+    // 工作线程从自己队列的尾部取任务，自己的队列为空时从其他队列的头部窃取，少数耗时任务不会拖住整个线程池
+    // 析构时执行完所有剩余任务后再回收线程
+    class ThreadPool {
+    public:
+        // threads 为 0 时使用硬件并发数
+        explicit ThreadPool(size_t threads = 0);
+        ~ThreadPool();
+        // 禁止拷贝和移动：工作线程持有 this
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        // 提交任务，返回任务结果的 future，任务抛出的异常由 future::get 重新抛出
+        template<typename F>
+        auto submit(F &&task) -> std::future<std::invoke_result_t<std::decay_t<F> > > {
+            using Result = std::invoke_result_t<std::decay_t<F> >;
+            // packaged_task 只能移动，包装在 shared_ptr 中以放入 std::function
+            auto packaged = std::make_shared<std::packaged_task<Result()> >(std::forward<F>(task));
+            std::future<Result> future = packaged->get_future();
+            enqueue([packaged] { (*packaged)(); });
+            return future;
+        }
+
+        // 工作线程数
+        [[nodiscard]] size_t size() const { return this->workers.size(); }
+
+    private:
+        // 单个工作线程的任务队列
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()> > jobs;
+        };
+
+        void enqueue(std::function<void()> job);
+        // 先取自己队列的尾部，再依次窃取其他队列的头部
+        bool take(size_t index, std::function<void()> &job);
+        void worker_loop(size_t index);
+
+        std::vector<std::unique_ptr<Queue> > queues;
+        std::vector<std::thread> workers;
+        std::atomic<size_t> next_queue{0}; // 外部提交时轮转的队列下标
+        std::atomic<size_t> pending{0};    // 已入队但尚未被取走的任务数
+        std::mutex sleep_mutex;            // 空闲线程休眠使用的锁
+        std::condition_variable ready;
+        bool stopping = false;
+    };
+}
+
+#endif //POCOM_THREAD_POOL_HPP
@@ -2,44 +2,130 @@
 // Created by aowei on 2025/9/15.
 //
 
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
-#include <regex>
 #include <vector>
-#include <fstream>
 #include <c11/lexer/scanner.hpp>
+#include <c11/lexer/stream.hpp>
+#include <utils/thread_pool.hpp>
+
+// 批量模式的命令行参数
+namespace {
+    struct Options {
+        std::string path = "-";     // 单文件模式的输入文件
+        std::string list;           // 批量模式的文件列表，非空时进入批量模式
+        size_t jobs = 0;            // 批量模式的线程数，0 表示硬件并发数
+    };
 
-std::string read_file_to_string(const std::string &filename) {
-    // 使用 C++17 的文件流，以二进制模式打开（避免文本模式下的换行符转换）
-    std::ifstream file(filename, std::ios::binary);
+    Options parse_options(const int argc, char **argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if ((arg == "--files" || arg == "--jobs") && i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            if (arg == "--files") {
+                options.list = argv[++i];
+            } else if (arg == "--jobs") {
+                options.jobs = std::stoul(argv[++i]);
+            } else {
+                options.path = arg;
+            }
+        }
+        return options;
+    }
 
-    // 检查文件是否成功打开
-    if (!file.is_open()) {
-        throw std::runtime_error("无法打开文件: " + filename + "（可能文件不存在或权限不足）");
+    // 读取文件列表：每行一个路径，忽略空行，列表为 "-" 时从标准输入读取
+    std::vector<std::string> read_list(const std::string &list) {
+        std::ifstream file;
+        if (list != "-") {
+            file.open(list);
+            if (!file) throw std::runtime_error("Failed to open file list '" + list + "'");
+        }
+        std::istream &in = list == "-" ? std::cin : file;
+        std::vector<std::string> paths;
+        for (std::string line; std::getline(in, line);) {
+            if (!line.empty()) paths.push_back(line);
+        }
+        return paths;
     }
 
-    // 检查文件是否可读
-    if (!file.good()) {
-        throw std::runtime_error("文件状态异常: " + filename);
+    // 标准输入：数据边到达边扫描，内存只与尚未消费的数据量有关，可以处理超过内存大小的输入
+    int scan_stdin(const c11::Scanner &scanner) {
+        c11::ChunkedTokenStream stream(scanner);
+        size_t tokens = 0, errors = 0;
+        const auto drain = [&] {
+            while (stream.next_token()) {
+                tokens++;
+                errors += stream.errors().size();
+            }
+        };
+        std::vector<char> chunk(64 * 1024);
+        while (std::cin.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || std::cin.gcount() > 0) {
+            stream.feed(std::string_view(chunk.data(), static_cast<size_t>(std::cin.gcount())));
+            drain();
+        }
+        stream.finish();
+        drain();
+        std::cout << tokens << std::endl;
+        return errors == 0 ? 0 : 1;
     }
 
-    // 使用 stringstream 作为中间缓冲区
-    std::stringstream buffer;
+    // 单文件模式：输出 Token 数量
+    int scan_single(const c11::Scanner &scanner, const std::string &path) {
+        const auto [tokens, errors] = scanner.scan_file(path);
+        std::cout << tokens.size() << std::endl;
+        return errors.empty() ? 0 : 1;
+    }
 
-    // 将文件内容复制到缓冲区（C++17 支持直接使用 istreambuf_iterator）
-    buffer << file.rdbuf();
+    // 批量模式：所有文件共享一个扫描器，输出汇总吞吐量
+    int scan_batch(const c11::Scanner &scanner, const Options &options) {
+        const std::vector<std::string> paths = read_list(options.list);
+        utils::ThreadPool pool(options.jobs);
+        const auto start = std::chrono::steady_clock::now();
+        const std::vector<c11::FileScanResult> results = scanner.scan_files(paths, pool);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-    // 检查读取过程是否出现错误
-    if (file.fail()) {
-        throw std::runtime_error("读取文件失败: " + filename);
+        size_t bytes = 0, tokens = 0, errors = 0, failures = 0;
+        for (const c11::FileScanResult &file: results) {
+            if (!file.failure.empty()) {
+                std::cerr << file.failure << std::endl;
+                failures++;
+                continue;
+            }
+            bytes += file.result.source->size();
+            tokens += file.result.tokens.size();
+            errors += file.result.errors.size();
+        }
+        std::cout << "files: " << results.size() << " (failed " << failures << ")"
+                << ", threads: " << pool.size()
+                << ", bytes: " << bytes
+                << ", tokens: " << tokens
+                << ", errors: " << errors
+                << ", seconds: " << seconds
+                << ", MB/s: " << (seconds > 0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0) << std::endl;
+        return failures ? 2 : errors ? 1 : 0;
     }
-    // 返回缓冲区内容作为字符串
-    return buffer.str();
 }
 
-int main() {
-    const std::string code = read_file_to_string(R"(/mnt/d/DEMOS/STU/CPP/pocom/codes/main.c)");
-    const c11::Scanner s;
-    const auto [tokens, errors] = s.scan(code);
-    std::cout << tokens.size();
+// 用法：pocom [file]，省略文件或文件为 "-" 时按数据块流式读取标准输入
+//      pocom --files <list> [--jobs N]，批量扫描列表中的文件（每行一个路径）并输出汇总吞吐量
+// 普通文件经 mmap 映射后直接扫描，不再经过文件流和字符串复制；以 POCOM_SCANNER_STATS 编译时额外输出热点统计
+int main(const int argc, char **argv) {
+    try {
+        const Options options = parse_options(argc, argv);
+        const c11::Scanner s;
+        const int status = !options.list.empty() ? scan_batch(s, options)
+                           : options.path == "-" ? scan_stdin(s)
+                           : scan_single(s, options.path);
+        // 以 POCOM_SCANNER_STATS 编译时，在标准错误输出各匹配器的热点统计
+        if constexpr (c11::Scanner::STATS_ENABLED) std::cerr << s.dump_statistics();
+        return status;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
 }
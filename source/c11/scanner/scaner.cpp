@@ -2,30 +2,23 @@
 // Created by aowei on 2025 9月 20.
 //
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
+#include <c11/lexer/keywords.hpp>
+#include <c11/lexer/punctuation.hpp>
 #include <c11/lexer/scanner.hpp>
-
-// 静态变量定义
-namespace c11 {
-    const std::vector<std::string> Scanner::keywords = {
-        "auto", "break", "case", "char", "const", "continue", "default", "do",
-        "double", "else", "enum", "extern", "float", "for", "goto", "if",
-        "int", "long", "register", "return", "short", "signed", "sizeof", "static",
-        "struct", "switch", "typedef", "union", "unsigned", "void", "volatile", "while"
-    };
-
-    const std::vector<std::string> Scanner::operators = {
-        "->", "++", "--", "<=", ">=", "==", "!=", "&&", "||",
-        "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<", ">>",
-        "<<=", ">>=", "+", "-", "*", "/", "%", "!", "&", "|", "^",
-        "~", "<", ">", "=", ".", "?", ":"
-    };
-
-    const std::vector<std::string> Scanner::punctuators = {
-        "(", ")", "{", "}", "[", "]", ";", ",", ":", "#", "##"
-    };
-}
+#include <lexer/regex/engine.hpp>
+#include <lexer/regex/rule_lexer.hpp>
+#include <lexer/simd/skip.hpp>
+#include <utils/thread_pool.hpp>
 
 // 匿名数据
 namespace c11 {
@@ -57,40 +50,189 @@ namespace c11 {
     }
 }
 
+// DFA 模式的规则定义
+namespace c11 {
+    namespace {
+        // 合并 DFA 中的规则编号，编号越小优先级越高（仅在匹配长度相同时起作用）
+        enum DFARule : int {
+            RULE_WHITESPACE,     // 空白字符
+            RULE_IDENTIFIER,     // 标识符/关键字
+            RULE_FLOAT,          // 浮点常量
+            RULE_INTEGER,        // 整数常量
+            RULE_LINE_COMMENT,   // 单行注释起始 //
+            RULE_BLOCK_COMMENT,  // 多行注释起始 /*
+            RULE_STRING,         // 字符串起始 "
+            RULE_CHAR,           // 字符常量起始 '
+            RULE_OPERATOR,       // 运算符
+            RULE_PUNCTUATOR,     // 标点符号
+            RULE_COUNT,
+        };
+
+        // 各规则在热点统计中的名称，与 REGEX 模式的匹配器同名，注释的两种起始分开统计
+        constexpr const char *DFA_RULE_NAMES[RULE_COUNT] = {
+            "whitespace", "identifier", "float", "integer", "line_comment", "block_comment", "string", "char",
+            "operator", "punctuator",
+        };
+
+        // 热点统计的时钟：x86 读取 TSC，其他平台使用单调时钟的纳秒数；未启用统计时恒为 0
+        uint64_t stats_clock() {
+            if constexpr (!Scanner::STATS_ENABLED) {
+                return 0;
+            } else {
+#if defined(__x86_64__) || defined(__i386__)
+                return __builtin_ia32_rdtsc();
+#else
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+            }
+        }
+
+        // 首字节即可确定规则的两类 Token：空白与标识符，直接交给 SIMD 跳过内核，不经过 DFA
+        bool is_whitespace_start(const char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+        }
+
+        bool is_identifier_start(const char c) {
+            const char lower = static_cast<char>(c | 0x20);
+            return (lower >= 'a' && lower <= 'z') || c == '_';
+        }
+
+        // 转义字面量中的正则元字符
+        std::string escape_literal(const std::string_view literal) {
+            static const std::string meta_chars = "*|()\\+?.[]{}^";
+            std::string escaped;
+            for (const char c: literal) {
+                if (meta_chars.find(c) != std::string::npos) escaped += '\\';
+                escaped += c;
+            }
+            return escaped;
+        }
+
+        // 多个子表达式的选择：(a|b|c)
+        std::string any_of(const std::vector<std::string> &alternatives) {
+            std::string regex = "(";
+            for (size_t i = 0; i < alternatives.size(); ++i) {
+                if (i) regex += '|';
+                regex += alternatives[i];
+            }
+            return regex + ")";
+        }
+
+        // 字面量列表中出现的所有首字符
+        template<size_t N>
+        std::string first_chars(const std::array<std::string_view, N> &literals) {
+            std::string chars;
+            for (const auto &literal: literals) {
+                if (chars.find(literal[0]) == std::string::npos) chars += literal[0];
+            }
+            return chars;
+        }
+
+        // C11 Token 规则表：顺序即优先级，Token 种类为 DFARule，由 RuleLexer 编译为一个合并的最小 DFA
+        // 注释、字符串与字符常量只匹配起始符号，其余部分由对应的处理函数扫描并报告错误
+        lexer::regex::RuleLexer build_token_lexer() {
+            // 浮点：尾数 + 可选指数 + 可选后缀
+            const std::string exponent = "[eE][+-]?[0-9]+";
+            const std::string float_rule = any_of({
+                any_of({"[0-9]+\\.[0-9]*", "\\.[0-9]+"}) + "(" + exponent + ")?[fFlL]?",
+                "[0-9]+" + exponent + "[fFlL]?"
+            });
+            // 整数：十六进制或十进制/八进制数字序列 + 可选后缀，八进制的合法性在匹配后检查
+            const std::string long_suffix = "(ll|LL|[lL])";
+            const std::string integer_rule = any_of({"0[xX][0-9a-fA-F]+", "[0-9]+"}) +
+                                             any_of({"[uU]" + long_suffix + "?", long_suffix + "[uU]?"}) + "?";
+            // 运算符与标点：字面量选择
+            std::vector<std::string> escaped_operators, escaped_punctuators;
+            for (const auto op: OPERATORS) escaped_operators.push_back(escape_literal(op));
+            for (const auto punc: PUNCTUATORS) escaped_punctuators.push_back(escape_literal(punc));
+
+            return lexer::regex::RuleLexer({
+                {"[ \t\n\r\f]+", RULE_WHITESPACE},
+                {"[a-zA-Z_][a-zA-Z0-9_]*", RULE_IDENTIFIER},
+                {float_rule, RULE_FLOAT},
+                {integer_rule, RULE_INTEGER},
+                {"//", RULE_LINE_COMMENT},
+                {"/\\*", RULE_BLOCK_COMMENT},
+                {"\"", RULE_STRING},
+                {"'", RULE_CHAR},
+                {any_of(escaped_operators), RULE_OPERATOR},
+                {any_of(escaped_punctuators), RULE_PUNCTUATOR},
+            });
+        }
+
+        // 所有 Scanner 共享的词法分析器，局部静态变量保证线程安全的一次性编译
+        const lexer::regex::RuleLexer &shared_token_lexer() {
+            static const lexer::regex::RuleLexer token_lexer = build_token_lexer();
+            return token_lexer;
+        }
+    }
+}
+
 // Scanner 类函数和辅助函数
 namespace c11 {
-    // 构造函数：初始化正则表达式
-    Scanner::Scanner() {
+    // REGEX 模式的正则与规则表描述同一组 Token，越过 Token 末尾读取的字节数以规则表为准
+    size_t Scanner::max_lookahead() {
+        return shared_token_lexer().max_lookahead();
+    }
+
+    // 构造函数：DFA 模式共享预编译的合并 DFA，REGEX 模式初始化正则表达式
+    Scanner::Scanner(const ScanMode mode) : mode(mode) {
+        if (mode == ScanMode::DFA) {
+            this->token_lexer = &shared_token_lexer();
+            init_statistics();
+            return;
+        }
         init_patterns();
-        // 使用模板函数初始化匹配器（匹配器的顺序就是优先级）
+        // 使用模板函数初始化匹配器（匹配器的顺序就是优先级），并注明各自可能的首字节
+        const std::string digits = "0123456789";
+        const std::string letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_";
         this->matchers = {
-            this->make_matcher<&Scanner::match_comments>("comment"),
-            this->make_matcher_static<&Scanner::match_string>("string"),
-            this->make_matcher_static<&Scanner::match_char>("char"),
-            this->make_matcher<&Scanner::match_float>("float"),
-            this->make_matcher<&Scanner::match_integer>("integer"),
-            this->make_matcher_static<&Scanner::match_operator>("operator"),
-            this->make_matcher_static<&Scanner::match_punctuator>("punctuator"),
-            this->make_matcher<&Scanner::match_identifier>("identifier"),
-            this->make_matcher<&Scanner::match_whitespace>("whitespace"),
+            make_matcher<&Scanner::match_comments>("comment", "/"),
+            make_matcher_static<&Scanner::match_string>("string", "\""),
+            make_matcher_static<&Scanner::match_char>("char", "'"),
+            make_matcher<&Scanner::match_float>("float", digits + "."),
+            make_matcher<&Scanner::match_integer>("integer", digits),
+            make_matcher_static<&Scanner::match_operator>("operator", first_chars(OPERATORS)),
+            make_matcher_static<&Scanner::match_punctuator>("punctuator", first_chars(PUNCTUATORS)),
+            make_matcher<&Scanner::match_identifier>("identifier", letters),
+            make_matcher<&Scanner::match_whitespace>("whitespace", " \t\n\r\f"),
         };
+        build_dispatch_table();
+        init_statistics();
+    }
+
+    // 构建首字节分派表：按字节计数排序，每个字节的候选保持匹配器的优先级顺序
+    void Scanner::build_dispatch_table() {
+        std::array<std::vector<uint8_t>, 256> candidates;
+        for (size_t i = 0; i < this->matchers.size(); ++i) {
+            for (const char c: this->matchers[i].first_bytes) {
+                candidates[static_cast<unsigned char>(c)].push_back(static_cast<uint8_t>(i));
+            }
+        }
+        this->dispatch_candidates.clear();
+        for (size_t b = 0; b < 256; ++b) {
+            this->dispatch_offsets[b] = static_cast<uint16_t>(this->dispatch_candidates.size());
+            this->dispatch_candidates.insert(this->dispatch_candidates.end(), candidates[b].begin(),
+                                             candidates[b].end());
+        }
+        this->dispatch_offsets[256] = static_cast<uint16_t>(this->dispatch_candidates.size());
     }
 
     //初始化正则表达式，精准匹配 C11 语法规则
     void Scanner::init_patterns() {
         // 标识符：字母/下划线开头，后接字母/数字/下划线
         this->regex_patterns[TokenType::TOK_IDENTIFIER] = std::regex("[a-zA-Z_][a-zA-Z0-9_]*");
-        // 整数常量：十进制（123）、八进制（0123）、十六进制（0x1a）
+        // 整数常量：十六进制（0x1a）或十进制/八进制数字序列（123、0123），可选 u/l/ll 后缀
+        // 与 DFA 模式的规则相同，八进制的合法性在匹配后检查，例如 089 报告为非法整数
         this->regex_patterns[TokenType::TOK_INTEGER] = std::regex(
-            "0x[0-9a-fA-F]+|0X[0-9a-fA-F]+" // 十六进制
-            "|0[0-7]*"                      // 八进制
-            "|[1-9][0-9]*"                  // 十进制
+            "(0[xX][0-9a-fA-F]+|[0-9]+)"                // 十六进制、十进制或八进制
+            "([uU](ll|LL|[lL])?|(ll|LL|[lL])[uU]?)?"    // 整数后缀
         );
-        // 浮点数常量：123.45、.45、123e-5、123.45e+6
+        // 浮点数常量：123.45、.45、123e-5、123.45e+6，可选 f/l 后缀
         this->regex_patterns[TokenType::TOK_FLOAT] = std::regex(
-            "[0-9]+\\.[0-9]*([eE][+-]?[0-9]+)?"
-            "|[0-9]*\\.[0-9]+([eE][+-]?[0-9]+)?"
-            "|[0-9]+[eE][+-]?[0-9]+"
+            "([0-9]+\\.[0-9]*|\\.[0-9]+)([eE][+-]?[0-9]+)?[fFlL]?"
+            "|[0-9]+[eE][+-]?[0-9]+[fFlL]?"
         );
         // 字符常量：支持转义字符
         this->regex_patterns[TokenType::TOK_CHAR] = std::regex(
@@ -109,25 +251,23 @@ namespace c11 {
     }
 
     // 检查是否为关键字
-    bool Scanner::is_keyword(const std::string &str) {
-        return std::binary_search(keywords.begin(), keywords.end(), str);
+    bool Scanner::is_keyword(const std::string_view str) {
+        return is_c11_keyword(str);
     }
 
-    // 检查字符串/字符常量中的非法转义序列
-    std::optional<ScanError> Scanner::check_escape_sequences(
-        const std::string &literal,
-        const size_t start_line,
-        const size_t start_column) {
+    // 检查字符串/字符常量中的非法转义序列，只有含反斜杠的字面量才需要查询起始位置
+    void Scanner::check_escape_sequences(const std::string_view literal, const size_t start_offset,
+                                         ScanResult &result) {
+        const auto [start_line, start_column] = result.source->position(start_offset);
         size_t pos = 0;
         size_t current_column = start_column;
         while (pos < literal.size()) {
             if (literal[pos] == '\\') {
                 // 转义序列在末尾
                 if (pos + 1 >= literal.size()) {
-                    return ScanError(
-                        ErrorType::ILLEGAL_ESCAPE,
-                        "Incomplete escape sequence (ends with '\\')",
-                        start_line, current_column);
+                    report_error(result, ErrorType::ILLEGAL_ESCAPE, {"Incomplete escape sequence (ends with '\\')"},
+                                 start_offset + pos, {start_line, current_column});
+                    return;
                 }
                 char esc = literal[pos + 1];
                 current_column += 2; // 转义字符占两列
@@ -151,12 +291,11 @@ namespace c11 {
                 // 3. 十六进制转义：\x 后必须跟至少 1 位十六进制数
                 if (esc == 'x') {
                     if (pos + 2 >= literal.size() || !std::isxdigit(literal[pos + 2])) {
-                        return ScanError(
-                            ErrorType::ILLEGAL_ESCAPE,
-                            "Hex escape sequence missing digits (\\x requirs 1+ hex digits)",
-                            start_line,
-                            current_column - 1 // 定位到 \x 的 x 处
-                        );
+                        report_error(result, ErrorType::ILLEGAL_ESCAPE,
+                                     {"Hex escape sequence missing digits (\\x requirs 1+ hex digits)"},
+                                     start_offset + pos + 1,
+                                     {start_line, current_column - 1}); // 定位到 \x 的 x 处
+                        return;
                     }
                     // 跳过所有十六进制数
                     int hex_length = 1;
@@ -168,54 +307,56 @@ namespace c11 {
                     continue;
                 }
                 // 4. 非法转义字符，例如 \z、\@ 等
-                return ScanError(
-                    ErrorType::ILLEGAL_ESCAPE,
-                    "Illegal escape sequence: \\" + std::string(1, esc),
-                    start_line,
-                    current_column - 1 // 定位到 \ 处
-                );
+                report_error(result, ErrorType::ILLEGAL_ESCAPE,
+                             {"Illegal escape sequence: \\", literal.substr(pos + 1, 1)},
+                             start_offset + pos,
+                             {start_line, current_column - 1}); // 定位到 \ 处
+                return;
             }
             // 非转义字符，正常通过
             pos++;
             current_column++;
         }
-        return std::nullopt;
     }
 
     // 处理未闭合的多行注释，正则无法匹配，需要手动扫描
-    void Scanner::handle_unclosed_comment(
-        const std::string &input,
-        size_t &pos, size_t line, size_t column,
-        ScanResult &result) {
+    void Scanner::handle_unclosed_comment(const std::string_view input, size_t &pos, ScanResult &result) {
         const size_t start_pos = pos;
         pos += 2; // 跳过 /*
         while (pos < input.size()) {
             if (input[pos] == '*' && pos + 1 < input.size() && input[pos + 1] == '/') {
                 // 找到闭合符：正常生成 COMMENT Token
-                std::string comment = input.substr(start_pos, pos + 2 - start_pos);
-                result.tokens.emplace_back(TokenType::TOK_COMMENT, comment, line, column);
+                const std::string_view comment = input.substr(start_pos, pos + 2 - start_pos);
+                result.tokens.emplace_back(TokenType::TOK_COMMENT, comment);
                 pos += 2;
                 return;
             }
-            // 处理换行
-            if (input[pos] == '\n') {
-                line++;
-                column = 1;
-            } else {
-                column++;
-            }
             pos++;
         }
-        // 输入结束时仍未找到 */：记录未闭合注释错误
-        std::string partial_comment = input.substr(start_pos);
-        result.errors.emplace_back(
-            ErrorType::INCOMPLETE_COMMENT,
-            "Unclosed multi-line comment (missing '*/')",
-            line,
-            column
-        );
+        // 输入结束时仍未找到 */：在输入末尾记录未闭合注释错误
+        const std::string_view partial_comment = input.substr(start_pos);
+        report_error(result, ErrorType::INCOMPLETE_COMMENT, {"Unclosed multi-line comment (missing '*/')"}, pos);
         // 生成部分注释 Token，便于定位
-        result.tokens.emplace_back(TokenType::TOK_COMMENT, partial_comment, line, column);
+        result.tokens.emplace_back(TokenType::TOK_COMMENT, partial_comment);
+    }
+
+    // 记录词法错误：只有出错时才查询行列号，首次查询会构建源缓冲区的换行索引
+    void Scanner::report_error(ScanResult &result, const ErrorType type,
+                               const std::initializer_list<std::string_view> message, const size_t offset) {
+        report_error(result, type, message, offset, result.source->position(offset));
+    }
+
+    // 错误描述直接拼接进 arena：arena 在第一个错误出现时创建，首块大小随输入规模增长，
+    // 整个扫描结果的所有描述文本随结果一起一次性释放
+    void Scanner::report_error(ScanResult &result, const ErrorType type,
+                               const std::initializer_list<std::string_view> message, const size_t offset,
+                               const SourcePosition position) {
+        if (!result.arena) {
+            const size_t first_block = std::clamp<size_t>(result.source->size() / 1024, 4096, utils::Arena::MAX_BLOCK);
+            result.arena = std::make_shared<utils::Arena>(first_block);
+        }
+        result.errors.emplace_back(type, result.arena->concat(message), position.line, position.column, offset,
+                                   result.arena);
     }
 
     // TokenType 转字符串
@@ -239,67 +380,30 @@ namespace c11 {
 
 // Scanner 扫描逻辑中的辅助函数，单个扫描函数
 namespace c11 {
-    // 辅助函数，用于更新位置信息
-    void Scanner::update_position(const std::string &matched_string, size_t &line, size_t &column) {
-        for (const char c: matched_string) {
-            if (c == '\n') {
-                line++;
-                column = 1;
-            } else if (c == '\t') {
-                column += 4;
-            } else {
-                column++;
-            }
-        }
-    }
-
     // 匹配注释
-    bool Scanner::match_comments(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                 ScanResult &result) const {
+    bool Scanner::match_comments(const std::string_view input, size_t &pos, ScanResult &result) const {
         const size_t input_length = input.length();
         // 先检查是否是多行注释开头（/*）但未闭合
-        if (pos + 1 < input_length && input.substr(pos, 2) == "/*") {
+        if (pos + 1 < input_length && input.compare(pos, 2, "/*") == 0) {
             // 尝试匹配完整注释，使用正则进行匹配
-            std::smatch match;
-            if (std::regex_search(input.cbegin() + static_cast<long>(pos), input.cend(), match,
+            std::cmatch match;
+            if (std::regex_search(input.data() + pos, input.data() + input.size(), match,
                                   this->regex_patterns.at(TokenType::TOK_COMMENT),
                                   std::regex_constants::match_continuous)) {
-                std::string comment = match.str();
-                size_t start_line = line;
-                size_t start_column = column;
-                // 更新位置
-                update_position(comment, line, column);
-                pos += comment.size();
-                // 添加 Token
-                result.tokens.emplace_back(TokenType::TOK_COMMENT, comment, start_line, start_column);
+                emit_token(TokenType::TOK_COMMENT, input, pos, match.length(), result);
             } else {
-                // 未闭合的多行注释：截取到输入的末尾
-                std::string incomplete_comment = input.substr(pos);
-                size_t start_line = line, start_column = column;
-                // 收集错误
-                result.errors.emplace_back(
-                    ErrorType::INCOMPLETE_COMMENT,
-                    "Unclosed multi-line comment (missing '*/')",
-                    start_line,
-                    start_column
-                );
-                // 更新位置到输入末尾
-                update_position(incomplete_comment, line, column);
-                pos = input_length;
-                // 添加 UNKNOWN Token （便于追踪）
-                result.tokens.emplace_back(TokenType::TOK_UNKNOWN, incomplete_comment, start_line, start_column);
+                // 未闭合的多行注释：截取到输入的末尾，收集错误并添加 UNKNOWN Token （便于追踪）
+                report_error(result, ErrorType::INCOMPLETE_COMMENT, {"Unclosed multi-line comment (missing '*/')"},
+                             pos);
+                emit_token(TokenType::TOK_UNKNOWN, input, pos, input_length - pos, result);
                 return true;
             }
-        } else if (pos + 1 < input_length && input.substr(pos, 2) == "//") {
-            std::smatch match;
-            if (std::regex_search(input.cbegin() + static_cast<long>(pos), input.end(), match,
+        } else if (pos + 1 < input_length && input.compare(pos, 2, "//") == 0) {
+            std::cmatch match;
+            if (std::regex_search(input.data() + pos, input.data() + input.size(), match,
                                   this->regex_patterns.at(TokenType::TOK_COMMENT),
                                   std::regex_constants::match_continuous)) {
-                std::string comment = match.str();
-                size_t start_line = line, start_column;
-                update_position(comment, line, column);
-                pos += comment.size();
-                result.tokens.emplace_back(TokenType::TOK_COMMENT, comment, start_line, start_column);
+                emit_token(TokenType::TOK_COMMENT, input, pos, match.length(), result);
                 return true;
             }
         }
@@ -307,92 +411,58 @@ namespace c11 {
     }
 
     // 匹配字符串常量
-    bool Scanner::match_string(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                               ScanResult &result) {
+    bool Scanner::match_string(const std::string_view input, size_t &pos, ScanResult &result) {
         const size_t input_length = input.length();
         if (input[pos] != '"') return false;
-        size_t start_line = line, start_column = column, end_pos = pos + 1;
         // 找闭合的 " （跳过转义的 "）
-        while (end_pos < input_length) {
-            if (input[end_pos] == '"' && input[end_pos - 1] != '\\') {
-                break; // 找到未转义的闭合的 "
-            }
-            end_pos++;
-        }
+        const size_t end_pos = lexer::simd::find_quote_end(input, pos + 1, '"');
         if (end_pos >= input_length) {
             // 未闭合的字符串：截止到输入末尾
-            std::string incomplete_string = input.substr(pos);
-            std::string message = "Unclosed string literal (missing '\"')";
-            result.errors.emplace_back(ErrorType::INCOMPLETE_STRING, message, start_line, start_column);
-            update_position(incomplete_string, line, column);
-            pos = input_length;
-            result.tokens.emplace_back(TokenType::TOK_UNKNOWN, incomplete_string, start_line, start_column);
+            report_error(result, ErrorType::INCOMPLETE_STRING, {"Unclosed string literal (missing '\"')"}, pos);
+            emit_token(TokenType::TOK_UNKNOWN, input, pos, input_length - pos, result);
         } else {
-            // 闭合字符串：检查转义错误
-            std::string string_literal = input.substr(pos, end_pos - pos + 1);
-            if (auto escape_err = check_escape_sequences(string_literal, start_line, start_column)) {
-                result.errors.push_back(std::move(*escape_err));
+            // 闭合字符串：检查转义错误，只有含反斜杠的字面量才需要起始位置
+            const std::string_view string_literal = input.substr(pos, end_pos - pos + 1);
+            if (string_literal.find('\\') != std::string_view::npos) {
+                check_escape_sequences(string_literal, pos, result);
             }
-            // 更新位置
-            update_position(string_literal, line, column);
-            pos = end_pos + 1;
-            result.tokens.emplace_back(TokenType::TOK_STRING, string_literal, start_line, start_column);
+            emit_token(TokenType::TOK_STRING, input, pos, string_literal.size(), result);
         }
         return true;
     }
 
     // 匹配字符常量
-    bool Scanner::match_char(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                             ScanResult &result) {
+    bool Scanner::match_char(const std::string_view input, size_t &pos, ScanResult &result) {
         const size_t input_length = input.length();
         if (input[pos] != '\'') return false;
-        size_t start_line = line, start_column = column, end_pos = pos + 1;
         // 找到闭合的 ' 跳过转义的 '
-        while (end_pos < input_length) {
-            if (input[end_pos] == '\'' && input[end_pos - 1] != '\\') {
-                break;
-            }
-            end_pos++;
-        }
+        const size_t end_pos = lexer::simd::find_quote_end(input, pos + 1, '\'');
         if (end_pos >= input_length) {
             // 处理未闭合字符
-            std::string incomplete_char = input.substr(pos);
-            std::string message = "Unclosed character literal (missing '\'')";
-            result.errors.emplace_back(ErrorType::INVALID_CHARACTER, message, start_line, start_column);
-            // 更新位置信息
-            update_position(incomplete_char, line, column);
-            pos = input_length;
-            result.tokens.emplace_back(TokenType::TOK_UNKNOWN, incomplete_char, line, column);
+            report_error(result, ErrorType::INVALID_CHARACTER, {"Unclosed character literal (missing '\'')"}, pos);
+            emit_token(TokenType::TOK_UNKNOWN, input, pos, input_length - pos, result);
         } else {
             // 闭合字符：检查转义 + 长度（c语言字符常量只能有一个字符）
-            std::string char_literal = input.substr(pos, end_pos - pos + 1);
-            if (auto escape_err = check_escape_sequences(char_literal, start_line, start_column)) {
-                result.errors.push_back(std::move(*escape_err));
+            const std::string_view char_literal = input.substr(pos, end_pos - pos + 1);
+            if (char_literal.find('\\') != std::string_view::npos) {
+                check_escape_sequences(char_literal, pos, result);
             }
-            // 更新位置信息
-            update_position(char_literal, line, column);
-            pos = end_pos + 1;
-            result.tokens.emplace_back(TokenType::TOK_CHAR, char_literal, start_line, start_column);
+            emit_token(TokenType::TOK_CHAR, input, pos, char_literal.size(), result);
         }
         return true;
     }
 
     // 匹配浮点常量
-    bool Scanner::match_float(const std::string &input, size_t &pos, const size_t &line, const size_t &column,
-                              ScanResult &result) const {
-        std::smatch match;
-        if (std::regex_search(input.cbegin() + static_cast<long>(pos), input.cend(), match,
+    bool Scanner::match_float(const std::string_view input, size_t &pos, ScanResult &result) const {
+        std::cmatch match;
+        if (std::regex_search(input.data() + pos, input.data() + input.size(), match,
                               this->regex_patterns.at(TokenType::TOK_FLOAT),
                               std::regex_constants::match_continuous
         )) {
-            std::string float_value = match.str();
-            size_t start_line = line, start_column = column;
+            const std::string_view float_value = input.substr(pos, match.length());
             // 确保不和整数冲突（例如："123." 是浮点数，"123" 是整数）
-            if (float_value.find('.') != std::string::npos ||
-                float_value.find('e') != std::string::npos ||
-                float_value.find('E') != std::string::npos) {
-                pos += float_value.size();
-                result.tokens.emplace_back(TokenType::TOK_FLOAT, float_value, start_line, start_column);
+            if (float_value.find_first_of(".eE") != std::string_view::npos) {
+                emit_token(TokenType::TOK_FLOAT, input, pos, float_value.size(), result);
                 return true;
             }
         }
@@ -400,155 +470,453 @@ namespace c11 {
     }
 
     // 匹配整数常量，含非法整数检测
-    bool Scanner::match_integer(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                ScanResult &result) const {
-        std::smatch match;
-        if (std::regex_search(input.cbegin() + static_cast<long>(pos), input.cend(), match,
+    bool Scanner::match_integer(const std::string_view input, size_t &pos, ScanResult &result) const {
+        std::cmatch match;
+        if (std::regex_search(input.data() + pos, input.data() + input.size(), match,
                               this->regex_patterns.at(TokenType::TOK_INTEGER),
                               std::regex_constants::match_continuous)) {
-            std::string integer_value = match.str();
-            size_t start_line = line, start_column = column;
-            bool invalid = false;
-            // 检测非法十六进制数，例如：0x1G、0XaH
-            if (integer_value.size() >= 2 && integer_value.substr(0, 2) == "0x" ||
-                integer_value.substr(0, 2) == "0X") {
-                for (size_t i = 2; i < integer_value.size(); ++i) {
-                    if (!std::isxdigit(integer_value[i])) {
-                        invalid = true;
-                    }
-                }
-            }
-            // 检测非法八进制数，例如 08、09
-            else if (integer_value[0] == '0' && integer_value.size() > 1) {
-                for (size_t i = 1; i < integer_value.size(); ++i) {
-                    if (integer_value[i] < '0' || integer_value[i] > '7') {
-                        invalid = true;
-                        break;
-                    }
-                }
-            }
-            // 收集非法整数错误
-            if (invalid) {
-                std::string message = "Invalid integer literal ('" + integer_value + "')";
-                result.errors.emplace_back(ErrorType::INVALID_INTEGER, message, start_line, start_column);
-            }
-            // 更新位置
-            update_position(integer_value, line, column);
-            pos += integer_value.size();
-            result.tokens.emplace_back(TokenType::TOK_INTEGER, integer_value, start_line, start_column);
+            emit_integer(input, pos, static_cast<size_t>(match.length()), result);
             return true;
         }
         return false;
     }
 
-    // 匹配运算符
-    bool Scanner::match_operator(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                 ScanResult &result) {
-        const size_t input_length = input.length();
-        for (const auto &op: operators) {
-            if (pos + op.size() > input_length) continue;
-            if (input.substr(pos, op.size()) == op) {
-                size_t start_line = line, start_column = column;
-                update_position(op, line, column);
-                pos += op.size();
-                result.tokens.emplace_back(TokenType::TOK_OPERATOR, op, start_line, start_column);
-                return true;
-            }
-        }
-        return false;
+    // 匹配运算符：字典树最长匹配，例如 <<= 不会被拆成 << 和 =
+    // 更长的标点（如 ... 之于 .）让给标点匹配器，与 DFA 模式的最长匹配一致
+    bool Scanner::match_operator(const std::string_view input, size_t &pos, ScanResult &result) {
+        const size_t length = longest_punctuation(input, pos, KIND_OPERATOR);
+        if (length == 0 || longest_punctuation(input, pos, KIND_PUNCTUATOR) > length) return false;
+        emit_token(TokenType::TOK_OPERATOR, input, pos, length, result);
+        return true;
     }
 
-    // 匹配标点符号
-    bool Scanner::match_punctuator(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                   ScanResult &result) {
-        const size_t input_length = input.length();
-        for (const auto &punc: punctuators) {
-            if (pos + punc.size() > input_length) continue;
-            if (input.substr(pos, punc.size()) == punc) {
-                size_t start_line = line, start_column = column;
-                update_position(punc, line, column);
-                pos += punc.size();
-                result.tokens.emplace_back(TokenType::TOK_PUNCTUATOR, punc, start_line, start_column);
-                return true;
-            }
-        }
-        return false;
+    // 匹配标点符号：字典树最长匹配，例如 ## 不会被拆成两个 #
+    bool Scanner::match_punctuator(const std::string_view input, size_t &pos, ScanResult &result) {
+        const size_t length = longest_punctuation(input, pos, KIND_PUNCTUATOR);
+        if (length == 0) return false;
+        emit_token(TokenType::TOK_PUNCTUATOR, input, pos, length, result);
+        return true;
     }
 
     // 匹配标识符/关键字
-    bool Scanner::match_identifier(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                   ScanResult &result) const {
-        std::smatch match;
-        if (std::regex_search(input.cbegin() + static_cast<long>(pos), input.cend(), match,
+    bool Scanner::match_identifier(const std::string_view input, size_t &pos, ScanResult &result) const {
+        std::cmatch match;
+        if (std::regex_search(input.data() + pos, input.data() + input.size(), match,
                               this->regex_patterns.at(TokenType::TOK_IDENTIFIER),
                               std::regex_constants::match_continuous)) {
-            std::string id = match.str();
-            size_t start_line = line, start_column = column;
-            TokenType type = is_keyword(id) ? TokenType::TOK_KEYWORD : TokenType::TOK_IDENTIFIER;
-            update_position(id, line, column);
-            pos += id.size();
-            result.tokens.emplace_back(type, id, start_line, start_column);
+            const std::string_view id = input.substr(pos, match.length());
+            const TokenType type = is_keyword(id) ? TokenType::TOK_KEYWORD : TokenType::TOK_IDENTIFIER;
+            emit_token(type, input, pos, id.size(), result);
             return true;
         }
         return false;
     }
 
     // 匹配空白字符
-    bool Scanner::match_whitespace(const std::string &input, size_t &pos, size_t &line, size_t &column,
+    bool Scanner::match_whitespace(const std::string_view input, size_t &pos,
                                    [[maybe_unused]] ScanResult &result) const {
-        std::smatch match;
-        if (std::regex_search(input.cbegin() + static_cast<long>(pos), input.cend(), match,
+        std::cmatch match;
+        if (std::regex_search(input.data() + pos, input.data() + input.size(), match,
                               this->regex_patterns.at(TokenType::TOK_WHITESPACE),
                               std::regex_constants::match_continuous)) {
-            const std::string whitespace = match.str();
-            // 空白字符不添加 Token，只更新位置
-            update_position(whitespace, line, column);
-            pos += whitespace.size();
+            // 空白字符不添加 Token，只前移位置
+            pos += match.length();
             return true;
         }
         return false;
     }
 
     // 处理无效字符
-    void Scanner::handle_invalid_char(const std::string &input, size_t &pos, size_t &line, size_t &column,
-                                      ScanResult &result) {
-        const char invalid_char = input[pos];
-        std::string char_string(1, invalid_char);
-        size_t start_line = line, start_column = column;
+    void Scanner::handle_invalid_char(const std::string_view input, size_t &pos, ScanResult &result) {
         // 收集错误
-        std::string message = "Invalid character ('" + char_string + "')";
-        result.errors.emplace_back(ErrorType::INVALID_CHARACTER, message, start_line, start_column);
-        // 更新位置
-        update_position(char_string, line, column);
-        pos++;
+        report_error(result, ErrorType::INVALID_CHARACTER, {"Invalid character ('", input.substr(pos, 1), "')"}, pos);
         // 添加 UNKNOWN Token
-        result.tokens.emplace_back(TokenType::TOK_UNKNOWN, char_string, start_line, start_column);
+        emit_token(TokenType::TOK_UNKNOWN, input, pos, 1, result);
+    }
+}
+
+// DFA 模式的单个扫描函数
+namespace c11 {
+    // 生成 Token 并前移扫描位置
+    void Scanner::emit_token(const TokenType type, const std::string_view input, size_t &pos, const size_t length,
+                             ScanResult &result) {
+        result.tokens.emplace_back(type, std::string_view(input.data() + pos, length));
+        pos += length;
+    }
+
+    // 匹配单行注释
+    void Scanner::match_line_comment(const std::string_view input, size_t &pos, ScanResult &result) {
+        const size_t end_pos = lexer::simd::find_byte(input, pos, '\n');
+        emit_token(TokenType::TOK_COMMENT, input, pos, end_pos - pos, result);
+    }
+
+    // 匹配多行注释
+    void Scanner::match_block_comment(const std::string_view input, size_t &pos, ScanResult &result) {
+        const size_t end_pos = lexer::simd::find_comment_end(input, pos + 2);
+        if (end_pos < input.size()) {
+            emit_token(TokenType::TOK_COMMENT, input, pos, end_pos + 2 - pos, result);
+            return;
+        }
+        // 未闭合的多行注释：截取到输入末尾，与 REGEX 模式一致生成 UNKNOWN Token
+        report_error(result, ErrorType::INCOMPLETE_COMMENT, {"Unclosed multi-line comment (missing '*/')"}, pos);
+        emit_token(TokenType::TOK_UNKNOWN, input, pos, input.size() - pos, result);
+    }
+
+    // 整数常量：十进制数字序列以 0 开头时按八进制检查，后缀不参与检查
+    void Scanner::emit_integer(const std::string_view input, size_t &pos, const size_t length,
+                                    ScanResult &result) {
+        const std::string_view integer_value(input.data() + pos, length);
+        const bool is_hex = length >= 2 && (integer_value[1] == 'x' || integer_value[1] == 'X');
+        if (!is_hex && integer_value[0] == '0') {
+            for (size_t i = 1; i < length && std::isdigit(static_cast<unsigned char>(integer_value[i])); ++i) {
+                if (integer_value[i] > '7') {
+                    report_error(result, ErrorType::INVALID_INTEGER, {"Invalid integer literal ('", integer_value, "')"}, pos);
+                    break;
+                }
+            }
+        }
+        emit_token(TokenType::TOK_INTEGER, input, pos, length, result);
     }
 }
 
 // Scaaner 核心逻辑函数
 namespace c11 {
-    // 核心扫描逻辑：逐个字符处理，手机 Token 和错误
-    ScanResult Scanner::scan(const std::string &input) const {
+    // 核心扫描接口：按照扫描模式分派
+    ScanResult Scanner::scan(std::string input) const {
+        return scan(SourceBuffer::from_string(std::move(input)));
+    }
+
+    // 扫描已加载的源缓冲区，结果共享该缓冲区
+    ScanResult Scanner::scan(std::shared_ptr<const SourceBuffer> source) const {
         ScanResult result;
-        size_t pos = 0;
-        size_t column = 1, line = 1;
-        const size_t input_length = input.size();
-        // 按照优先级一次调用匹配函数
-        while (pos < input_length) {
+        result.source = std::move(source);
+        const std::string_view input = result.source->view();
+        // 典型 C 代码平均每个 Token 连同空白约占 4~8 字节，预留后扫描过程中 Token 数组不再反复扩容
+        result.tokens.reserve(input.size() / 6);
+        scan_range(input, 0, input.size(), result);
+        return result;
+    }
+
+    // 扫描文件：普通文件直接映射到内存，不复制文件内容
+    ScanResult Scanner::scan_file(const std::string &path) const {
+        return scan(SourceBuffer::from_file(path));
+    }
+
+    // 从 pos 开始逐个识别 Token，直到某个 Token 的起点不小于 end，返回停止位置（可能越过 end）
+    // 每一步只依赖起点 pos，与之前的扫描历史无关，这是分块并行扫描能够拼接的前提
+    size_t Scanner::scan_range(const std::string_view input, const size_t pos, const size_t end,
+                               ScanResult &result) const {
+        return this->mode == ScanMode::DFA ? scan_dfa(input, pos, end, result) : scan_regex(input, pos, end, result);
+    }
+
+    // DFA 模式：每个 Token 只沿合并 DFA 线性前进一次，由命中的规则决定 Token 类型
+    size_t Scanner::scan_dfa(const std::string_view input, size_t pos, const size_t end, ScanResult &result) const {
+        while (pos < end) {
+            const size_t start = pos;
+            const uint64_t started = stats_clock();
+            // 空白与标识符由 SIMD 内核一次跳过一整段，其余 Token 沿合并 DFA 最长匹配
+            lexer::regex::LexMatch match;
+            if (is_whitespace_start(input[pos])) {
+                match = {lexer::simd::skip_whitespace(input, pos) - pos, RULE_WHITESPACE, RULE_WHITESPACE};
+            } else if (is_identifier_start(input[pos])) {
+                match = {lexer::simd::skip_identifier(input, pos) - pos, RULE_IDENTIFIER, RULE_IDENTIFIER};
+            } else {
+                match = this->token_lexer->next_token(input, pos);
+            }
+            const size_t length = match.length;
+            const int rule = match.kind;
+            if (length == 0) {
+                handle_invalid_char(input, pos, result);
+                record_stat(RULE_COUNT, true, pos - start, stats_clock() - started);
+                continue;
+            }
+            switch (rule) {
+                case RULE_WHITESPACE:
+                    // 空白字符不添加 Token，只前移位置
+                    pos += length;
+                    break;
+                case RULE_IDENTIFIER: {
+                    const std::string_view id(input.data() + pos, length);
+                    const TokenType type = is_keyword(id) ? TokenType::TOK_KEYWORD : TokenType::TOK_IDENTIFIER;
+                    emit_token(type, input, pos, length, result);
+                    break;
+                }
+                case RULE_FLOAT:
+                    emit_token(TokenType::TOK_FLOAT, input, pos, length, result);
+                    break;
+                case RULE_INTEGER:
+                    emit_integer(input, pos, length, result);
+                    break;
+                case RULE_LINE_COMMENT:
+                    match_line_comment(input, pos, result);
+                    break;
+                case RULE_BLOCK_COMMENT:
+                    match_block_comment(input, pos, result);
+                    break;
+                case RULE_STRING:
+                    match_string(input, pos, result);
+                    break;
+                case RULE_CHAR:
+                    match_char(input, pos, result);
+                    break;
+                case RULE_OPERATOR:
+                    emit_token(TokenType::TOK_OPERATOR, input, pos, length, result);
+                    break;
+                case RULE_PUNCTUATOR:
+                    emit_token(TokenType::TOK_PUNCTUATOR, input, pos, length, result);
+                    break;
+                default:
+                    handle_invalid_char(input, pos, result);
+                    break;
+            }
+            record_stat(rule >= 0 && rule < RULE_COUNT ? rule : RULE_COUNT, true, pos - start, stats_clock() - started);
+        }
+        return pos;
+    }
+
+    // REGEX 模式：逐个字符处理，收集 Token 和错误
+    size_t Scanner::scan_regex(const std::string_view input, size_t pos, const size_t end, ScanResult &result) const {
+        // 按照首字节分派到候选匹配器，候选内部按照优先级依次调用
+        while (pos < end) {
             bool matched = false;
-            // 遍历所有的匹配器，按照优先级尝试匹配
-            for (const auto &[func, _]: this->matchers) {
-                if (func(input, pos, line, column, result)) {
+            const auto byte = static_cast<unsigned char>(input[pos]);
+            for (uint16_t i = this->dispatch_offsets[byte]; i < this->dispatch_offsets[byte + 1]; ++i) {
+                if (try_matcher(this->dispatch_candidates[i], input, pos, result)) {
                     matched = true;
                     break;
                 }
             }
             // 当所有的匹配都失败的时候：处理无效字符
             if (!matched) {
-                handle_invalid_char(input, pos, line, column, result);
+                const size_t start = pos;
+                handle_invalid_char(input, pos, result);
+                record_stat(this->matchers.size(), true, pos - start, 0);
+            }
+        }
+        return pos;
+    }
+}
+
+// 分块并行扫描
+namespace c11 {
+    namespace {
+        // 一个分块的投机扫描结果：从块起点开始扫描，直到 Token 起点越过块终点
+        struct ChunkScan {
+            size_t begin = 0; // 块起点（投机扫描的起点）
+            size_t stop = 0;  // 投机扫描的停止位置，不小于块终点
+            ScanResult result;
+        };
+
+        // 块内第一个起点不小于 pos 的 Token 下标
+        size_t first_token_at(const ScanResult &chunk, const size_t pos) {
+            const auto it = std::lower_bound(chunk.tokens.begin(), chunk.tokens.end(), pos,
+                                             [&chunk](const Token &token, const size_t offset) {
+                                                 return chunk.offset(token) < offset;
+                                             });
+            return static_cast<size_t>(it - chunk.tokens.begin());
+        }
+
+        // pos 是否为投机扫描中某一步的起点：块起点、某个 Token 的起点或终点（其后紧跟下一步，空白也从这里开始）
+        bool is_step_start(const ChunkScan &chunk, const size_t pos, const size_t token_index) {
+            if (pos == chunk.begin) return true;
+            const std::vector<Token> &tokens = chunk.result.tokens;
+            if (token_index < tokens.size() && chunk.result.offset(tokens[token_index]) == pos) return true;
+            if (token_index == 0) return false;
+            const Token &previous = tokens[token_index - 1];
+            return chunk.result.offset(previous) + previous.value.size() == pos;
+        }
+    }
+
+    // 并行扫描：按行对齐切分输入，各块在线程池上从块起点投机扫描，再按顺序拼接
+    // 拼接时已确定的扫描位置若是下一块投机扫描中某一步的起点，之后的结果与串行扫描逐项相同，直接拼接；
+    // 否则（块边界落在注释、字符串或多字符运算符内部）从该位置串行扫描，直到与投机扫描重新同步
+    ScanResult Scanner::scan_parallel(std::shared_ptr<const SourceBuffer> source, utils::ThreadPool &pool,
+                                      const size_t chunk_size) const {
+        if (chunk_size == 0) throw std::invalid_argument("Parallel scan chunk size must be positive");
+        const std::string_view input = source->view();
+        // 1. 切分：块终点对齐到下一个换行符之后，行首通常就是 Token 的起点
+        std::vector<size_t> bounds{0};
+        while (input.size() - bounds.back() > chunk_size) {
+            const size_t bound = lexer::simd::find_byte(input, bounds.back() + chunk_size, '\n') + 1;
+            if (bound >= input.size()) break;
+            bounds.push_back(bound);
+        }
+        bounds.push_back(input.size());
+        if (bounds.size() == 2) return scan(std::move(source));
+
+        // 2. 投机扫描：各块互不依赖，提交到线程池
+        std::vector<ChunkScan> chunks(bounds.size() - 1);
+        std::vector<std::future<void> > pending;
+        pending.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            pending.push_back(pool.submit([this, &chunks, &bounds, &source, input, i] {
+                ChunkScan &chunk = chunks[i];
+                chunk.begin = bounds[i];
+                chunk.result.source = source;
+                chunk.stop = scan_range(input, bounds[i], bounds[i + 1], chunk.result);
+            }));
+        }
+        for (std::future<void> &task: pending) task.get();
+
+        // 3. 拼接：第一块的起点就是真实起点，直接采用
+        ScanResult result = std::move(chunks[0].result);
+        size_t total_tokens = 0;
+        for (const ChunkScan &chunk: chunks) total_tokens += chunk.result.tokens.size();
+        result.tokens.reserve(total_tokens);
+        size_t pos = chunks[0].stop;
+        for (size_t i = 1; i < chunks.size(); ++i) {
+            ChunkScan &chunk = chunks[i];
+            while (pos < chunk.stop) {
+                const size_t token_index = first_token_at(chunk.result, pos);
+                if (is_step_start(chunk, pos, token_index)) {
+                    // 已同步：拼接 pos 之后的 Token 与错误
+                    const std::vector<Token> &tokens = chunk.result.tokens;
+                    result.tokens.insert(result.tokens.end(), tokens.begin() + static_cast<ptrdiff_t>(token_index),
+                                         tokens.end());
+                    // 错误共享持有块的 arena，直接拷贝即可
+                    for (const ScanError &error: chunk.result.errors) {
+                        if (error.offset >= pos) result.errors.push_back(error);
+                    }
+                    pos = chunk.stop;
+                    break;
+                }
+                // 未同步：串行前进一步后重试
+                pos = scan_range(input, pos, pos + 1, result);
             }
         }
+        // 最后一块之后不会再有输入，pos 已到达末尾
         return result;
     }
 }
+
+// 多文件批量扫描
+namespace c11 {
+    // 先提交大文件：大文件尽早开始，小文件在最后填补空闲线程，整体完成时间更短
+    std::vector<FileScanResult> Scanner::scan_files(const std::vector<std::string> &paths,
+                                                    utils::ThreadPool &pool) const {
+        // 1. 按文件大小从大到小排列提交顺序，无法获取大小的文件排在最后，由扫描任务报告错误
+        std::vector<uintmax_t> sizes(paths.size(), 0);
+        for (size_t i = 0; i < paths.size(); ++i) {
+            std::error_code error;
+            const uintmax_t size = std::filesystem::file_size(paths[i], error);
+            if (!error) sizes[i] = size;
+        }
+        std::vector<size_t> order(paths.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&sizes](const size_t a, const size_t b) {
+            return sizes[a] > sizes[b];
+        });
+
+        // 2. 每个文件一个任务，结果写入各自的槽位，异常只影响对应文件
+        std::vector<FileScanResult> results(paths.size());
+        std::vector<std::future<void> > pending;
+        pending.reserve(paths.size());
+        for (const size_t i: order) {
+            pending.push_back(pool.submit([this, &paths, &results, i] {
+                FileScanResult &file = results[i];
+                file.path = paths[i];
+                try {
+                    file.result = scan_file(paths[i]);
+                } catch (const std::exception &e) {
+                    file.failure = e.what();
+                }
+            }));
+        }
+        for (std::future<void> &task: pending) task.get();
+        return results;
+    }
+}
+
+// 热点统计
+namespace c11 {
+    // 统计项与匹配器（或规则）一一对应，最后追加无效字符
+    void Scanner::init_statistics() {
+        if constexpr (!STATS_ENABLED) return;
+        this->stat_names.clear();
+        if (this->mode == ScanMode::DFA) {
+            this->stat_names.assign(std::begin(DFA_RULE_NAMES), std::end(DFA_RULE_NAMES));
+        } else {
+            for (const Matcher &matcher: this->matchers) this->stat_names.push_back(matcher.name);
+        }
+        this->stat_names.emplace_back("invalid");
+        this->stat_counters = std::make_unique<StatCounters[]>(this->stat_names.size());
+    }
+
+    void Scanner::record_stat(const size_t slot, const bool hit, const size_t bytes, const uint64_t cycles) const {
+        if constexpr (!STATS_ENABLED) return;
+        StatCounters &counters = this->stat_counters[slot];
+        counters.attempts.fetch_add(1, std::memory_order_relaxed);
+        counters.cycles.fetch_add(cycles, std::memory_order_relaxed);
+        if (hit) {
+            counters.hits.fetch_add(1, std::memory_order_relaxed);
+            counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    bool Scanner::try_matcher(const size_t index, const std::string_view input, size_t &pos,
+                              ScanResult &result) const {
+        if constexpr (!STATS_ENABLED) {
+            return this->matchers[index].func(*this, input, pos, result);
+        } else {
+            const size_t start = pos;
+            const uint64_t started = stats_clock();
+            const bool hit = this->matchers[index].func(*this, input, pos, result);
+            record_stat(index, hit, pos - start, stats_clock() - started);
+            return hit;
+        }
+    }
+
+    std::vector<MatcherStats> Scanner::statistics() const {
+        std::vector<MatcherStats> stats;
+        if (!this->stat_counters) return stats;
+        for (size_t i = 0; i < this->stat_names.size(); ++i) {
+            const StatCounters &counters = this->stat_counters[i];
+            stats.push_back({
+                this->stat_names[i],
+                counters.attempts.load(std::memory_order_relaxed),
+                counters.hits.load(std::memory_order_relaxed),
+                counters.bytes.load(std::memory_order_relaxed),
+                counters.cycles.load(std::memory_order_relaxed),
+            });
+        }
+        return stats;
+    }
+
+    void Scanner::reset_statistics() const {
+        if (!this->stat_counters) return;
+        for (size_t i = 0; i < this->stat_names.size(); ++i) {
+            StatCounters &counters = this->stat_counters[i];
+            counters.attempts.store(0, std::memory_order_relaxed);
+            counters.hits.store(0, std::memory_order_relaxed);
+            counters.bytes.store(0, std::memory_order_relaxed);
+            counters.cycles.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // 每行：名称、尝试次数、成功次数、命中率、字节数、累计周期、每次尝试的平均周期、周期占比
+    std::string Scanner::dump_statistics() const {
+        const std::vector<MatcherStats> stats = statistics();
+        if (stats.empty()) return "scanner statistics disabled (build with POCOM_SCANNER_STATS)\n";
+        uint64_t total_cycles = 0;
+        for (const MatcherStats &item: stats) total_cycles += item.cycles;
+        std::ostringstream out;
+        out << std::left << std::setw(16) << "matcher" << std::right
+                << std::setw(14) << "attempts" << std::setw(14) << "hits" << std::setw(8) << "hit%"
+                << std::setw(14) << "bytes" << std::setw(16) << "cycles" << std::setw(12) << "cyc/try"
+                << std::setw(8) << "time%" << '\n';
+        out << std::fixed << std::setprecision(1);
+        for (const MatcherStats &item: stats) {
+            const double attempts = static_cast<double>(item.attempts);
+            out << std::left << std::setw(16) << item.name << std::right
+                    << std::setw(14) << item.attempts << std::setw(14) << item.hits
+                    << std::setw(8) << (item.attempts ? 100.0 * static_cast<double>(item.hits) / attempts : 0.0)
+                    << std::setw(14) << item.bytes << std::setw(16) << item.cycles
+                    << std::setw(12) << (item.attempts ? static_cast<double>(item.cycles) / attempts : 0.0)
+                    << std::setw(8) << (total_cycles
+                                            ? 100.0 * static_cast<double>(item.cycles) / static_cast<double>(total_cycles)
+                                            : 0.0)
+                    << '\n';
+        }
+        return out.str();
+    }
+}
@@ -0,0 +1,123 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <c11/lexer/source.hpp>
+#include <lexer/simd/skip.hpp>
+
+// 文件读取辅助函数
+namespace c11 {
+    namespace {
+        // 带系统错误描述的异常
+        std::runtime_error io_error(const std::string &action, const std::string &path) {
+            return std::runtime_error("Failed to " + action + " '" + path + "': " + std::strerror(errno));
+        }
+
+        // 不可映射的输入：循环 read 直到文件结束
+        std::string read_all(const int fd, const std::string &path) {
+            std::string text;
+            char chunk[64 * 1024];
+            while (true) {
+                const ssize_t count = ::read(fd, chunk, sizeof(chunk));
+                if (count == 0) break;
+                if (count < 0) {
+                    if (errno == EINTR) continue;
+                    throw io_error("read", path);
+                }
+                text.append(chunk, static_cast<size_t>(count));
+            }
+            return text;
+        }
+
+        // 关闭文件描述符的守卫，映射建立后即可关闭
+        struct FileDescriptor {
+            int fd;
+            ~FileDescriptor() { if (this->fd > STDIN_FILENO) ::close(this->fd); }
+        };
+    }
+}
+
+// SourceBuffer 的实现
+namespace c11 {
+    SourceBuffer::~SourceBuffer() {
+        if (this->mapped) ::munmap(const_cast<char *>(this->data), this->length);
+    }
+
+    // 由字符串构造
+    std::shared_ptr<const SourceBuffer> SourceBuffer::from_string(std::string text) {
+        std::shared_ptr<SourceBuffer> buffer(new SourceBuffer());
+        buffer->owned = std::move(text);
+        buffer->data = buffer->owned.data();
+        buffer->length = buffer->owned.size();
+        return buffer;
+    }
+
+    // 由外部内存构造：只记录地址与长度
+    std::shared_ptr<const SourceBuffer> SourceBuffer::from_view(const std::string_view text) {
+        std::shared_ptr<SourceBuffer> buffer(new SourceBuffer());
+        buffer->data = text.data();
+        buffer->length = text.size();
+        return buffer;
+    }
+
+    // 由文件构造：普通且非空的文件 mmap 映射，其余情况读入内存
+    std::shared_ptr<const SourceBuffer> SourceBuffer::from_file(const std::string &path) {
+        const FileDescriptor file{path == "-" ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (file.fd < 0) throw io_error("open", path);
+        struct stat info{};
+        if (::fstat(file.fd, &info) != 0) throw io_error("stat", path);
+        if (!S_ISREG(info.st_mode) || info.st_size == 0) {
+            return from_string(read_all(file.fd, path));
+        }
+        const auto length = static_cast<size_t>(info.st_size);
+        void *address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (address == MAP_FAILED) {
+            // 不支持映射的文件系统：回退为读入内存
+            return from_string(read_all(file.fd, path));
+        }
+        // 扫描是严格的顺序访问，提示内核预读
+        ::madvise(address, length, MADV_SEQUENTIAL);
+        std::shared_ptr<SourceBuffer> buffer(new SourceBuffer());
+        buffer->data = static_cast<const char *>(address);
+        buffer->length = length;
+        buffer->mapped = true;
+        return buffer;
+    }
+
+    // 每一行首字节的偏移：首次调用时构建，换行符由 SIMD 内核逐段查找
+    const std::vector<size_t> &SourceBuffer::line_index() const {
+        std::call_once(this->lines_built, [this] {
+            const std::string_view text = this->view();
+            this->line_starts.push_back(0);
+            for (size_t pos = lexer::simd::find_byte(text, 0, '\n'); pos < text.size();
+                 pos = lexer::simd::find_byte(text, pos + 1, '\n')) {
+                this->line_starts.push_back(pos + 1);
+            }
+        });
+        return this->line_starts;
+    }
+
+    // 字节偏移 -> 行号：二分查找偏移所在的行
+    size_t SourceBuffer::line(const size_t offset) const {
+        const std::vector<size_t> &starts = line_index();
+        return static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin());
+    }
+
+    // 字节偏移 -> 行列号
+    SourcePosition SourceBuffer::position(size_t offset) const {
+        offset = std::min(offset, this->length);
+        const size_t line = this->line(offset);
+        const size_t line_start = this->line_starts[line - 1];
+        // 列号只需扫描该行行首到偏移处的字节：制表符占 4 列，其余字节占 1 列
+        const size_t tabs = static_cast<size_t>(std::count(this->data + line_start, this->data + offset, '\t'));
+        return {line, 1 + (offset - line_start) + 3 * tabs};
+    }
+}
@@ -0,0 +1,124 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <c11/lexer/stream.hpp>
+#include <lexer/regex/rule_lexer.hpp>
+
+// 辅助函数
+namespace c11 {
+    namespace {
+        // 越过 consumed 之后的行列号：只扫描被消费的前缀，不构建整个窗口的换行索引
+        SourcePosition advance(const SourcePosition start, const std::string_view consumed) {
+            const size_t last_newline = consumed.rfind('\n');
+            const std::string_view tail = last_newline == std::string_view::npos
+                                              ? consumed
+                                              : consumed.substr(last_newline + 1);
+            // 制表符占 4 列，与 SourceBuffer::position 一致
+            const size_t columns = tail.size() + 3 * static_cast<size_t>(std::count(tail.begin(), tail.end(), '\t'));
+            if (last_newline == std::string_view::npos) return {start.line, start.column + columns};
+            const auto lines = static_cast<size_t>(std::count(consumed.begin(), consumed.end(), '\n'));
+            return {start.line + lines, 1 + columns};
+        }
+    }
+}
+
+// TokenStream 的实现
+namespace c11 {
+    TokenStream::TokenStream(const Scanner &scanner, std::shared_ptr<const SourceBuffer> source) :
+        scanner(&scanner) {
+        this->step.source = std::move(source);
+        this->input = this->step.source->view();
+    }
+
+    // 每次只扫描一个步骤，空白步骤不产生 Token，继续下一步
+    std::optional<Token> TokenStream::next_token() {
+        while (this->next >= this->step.tokens.size()) {
+            if (this->pos >= this->input.size()) return std::nullopt;
+            // 上一步骤的 arena 随之释放，调用方已取走的错误共享持有它，内存与输入大小无关
+            this->step.tokens.clear();
+            this->step.errors.clear();
+            this->step.arena.reset();
+            this->next = 0;
+            this->pos = this->scanner->scan_range(this->input, this->pos, this->pos + 1, this->step);
+        }
+        // 同一步骤产生多个 Token 时，错误只随第一个 Token 报告一次
+        if (this->next > 0) this->step.errors.clear();
+        return this->step.tokens[this->next++];
+    }
+}
+
+// ChunkedTokenStream 的实现
+namespace c11 {
+    ChunkedTokenStream::ChunkedTokenStream(const Scanner &scanner) : scanner(&scanner),
+                                                                     lookahead(Scanner::max_lookahead()) {
+        if (this->lookahead == lexer::regex::RuleLexer::UNBOUNDED) {
+            throw std::logic_error("Token rules read an unbounded number of bytes past a token");
+        }
+        this->window = SourceBuffer::from_view(this->text);
+        this->step.source = this->window;
+    }
+
+    // 从缓冲区前端移除已消费的前缀，再在原处追加新数据
+    void ChunkedTokenStream::feed(const std::string_view data) {
+        if (this->finished) throw std::logic_error("Cannot feed a finished token stream");
+        // 1. 前移窗口起点的偏移与行列号
+        this->base_position = advance(this->base_position, std::string_view(this->text).substr(0, this->pos));
+        this->base_offset += this->pos;
+        this->retry_size = this->retry_size > this->pos ? this->retry_size - this->pos : 0;
+        // 2. 原地压缩并追加，缓冲区容量只随未消费的数据量增长
+        this->text.erase(0, this->pos);
+        this->text.append(data);
+        // 3. 新窗口只是缓冲区的视图；之前返回的 Token 随之失效，上一个窗口的 arena 在此释放，
+        // 调用方已取走的错误共享持有它，不受影响
+        this->window = SourceBuffer::from_view(this->text);
+        this->pos = 0;
+        this->step.tokens.clear();
+        this->step.errors.clear();
+        this->step.arena.reset();
+        this->step.source = this->window;
+        this->next = 0;
+    }
+
+    void ChunkedTokenStream::finish() {
+        this->finished = true;
+    }
+
+    bool ChunkedTokenStream::exhausted() const {
+        return this->finished && this->pos >= this->window->size() && this->next >= this->step.tokens.size();
+    }
+
+    // 扫描一个步骤，结果可能被后续数据改变时撤销该步骤，等待更多数据
+    std::optional<Token> ChunkedTokenStream::next_token() {
+        const std::string_view input = this->window->view();
+        while (this->next >= this->step.tokens.size()) {
+            if (this->pos >= input.size()) return std::nullopt;
+            if (!this->finished && input.size() < this->retry_size) return std::nullopt;
+            this->step.tokens.clear();
+            this->step.errors.clear();
+            this->next = 0;
+            const size_t end = this->scanner->scan_range(input, this->pos, this->pos + 1, this->step);
+            if (!this->finished && end + this->lookahead > input.size()) {
+                // 撤销该步骤，等未消费的数据翻倍后再重试
+                this->step.tokens.clear();
+                this->step.errors.clear();
+                this->retry_size = 2 * input.size() - this->pos;
+                ++this->undone_steps;
+                return std::nullopt;
+            }
+            // 错误的行列号与偏移由窗口内转换为整个输入
+            for (ScanError &error: this->step.errors) {
+                if (error.line == 1) error.column += this->base_position.column - 1;
+                error.line += this->base_position.line - 1;
+                error.offset += this->base_offset;
+            }
+            this->pos = end;
+        }
+        // 同一步骤产生多个 Token 时，错误只随第一个 Token 报告一次
+        if (this->next > 0) this->step.errors.clear();
+        return this->step.tokens[this->next++];
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <c11/lexer/token_buffer.hpp>
+
+// TokenBuffer 的实现
+namespace c11 {
+    TokenBuffer::TokenBuffer(std::shared_ptr<const SourceBuffer> source, const bool with_lines) :
+        source_buffer(std::move(source)), with_lines(with_lines) {
+        if (this->source_buffer->size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::invalid_argument("TokenBuffer supports inputs up to 4 GiB");
+        }
+    }
+
+    // 追加一个 Token：偏移由 value 在源缓冲区中的位置得到
+    void TokenBuffer::push_back(const Token &token) {
+        const auto offset = static_cast<size_t>(token.value.data() - this->source_buffer->view().data());
+        this->kind_column.push_back(static_cast<uint8_t>(token.type));
+        this->offset_column.push_back(static_cast<uint32_t>(offset));
+        this->length_column.push_back(static_cast<uint32_t>(token.value.size()));
+        if (this->with_lines) {
+            this->line_column.push_back(static_cast<uint32_t>(this->source_buffer->line(offset)));
+        }
+    }
+
+    void TokenBuffer::reserve(const size_t count) {
+        this->kind_column.reserve(count);
+        this->offset_column.reserve(count);
+        this->length_column.reserve(count);
+        if (this->with_lines) this->line_column.reserve(count);
+    }
+}
+
+// Scanner 的结构数组输出
+namespace c11 {
+    // 按固定大小的窗口扫描：每个窗口的 Token 先写入可复用的临时结果，再逐列追加，临时结果始终留在缓存中
+    // 临时结果的 arena 在各窗口之间保留，复制出去的错误共享持有它，错误描述始终有效
+    TokenBuffer Scanner::scan_token_buffer(std::shared_ptr<const SourceBuffer> source, const bool with_lines) const {
+        constexpr size_t WINDOW = 64 * 1024;
+        TokenBuffer buffer(source, with_lines);
+        const std::string_view input = source->view();
+        // 典型 C 代码平均每个 Token 连同空白约占 4~8 字节
+        buffer.reserve(input.size() / 6);
+
+        ScanResult window;
+        window.source = std::move(source);
+        size_t pos = 0;
+        while (pos < input.size()) {
+            pos = scan_range(input, pos, std::min(pos + WINDOW, input.size()), window);
+            for (const Token &token: window.tokens) buffer.push_back(token);
+            buffer.errors().insert(buffer.errors().end(), window.errors.begin(), window.errors.end());
+            window.tokens.clear();
+            window.errors.clear();
+        }
+        return buffer;
+    }
+}
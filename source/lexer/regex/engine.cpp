@@ -5,44 +5,76 @@
 #include <algorithm>
 #include <iostream>
 #include <atomic>
+#include <map>
 #include <queue>
 #include <stack>
+#include <unordered_set>
 #include <lexer/regex/engine.hpp>
 
-// 匿名命名空间：状态 ID 计数器（线程安全）
+// 匿名命名空间：DFA 状态 ID 计数器（线程安全），NFA 状态以数组下标为编号
 namespace lexer::regex {
     namespace {
-        std::atomic<int> nfa_state_id_counter{0};
         std::atomic<int> dfa_state_id_counter{0};
+
+        // 调试输出用：单个字节直接打印，多个字节打印集合大小
+        std::string describe_label(const CharSet &label) {
+            if (label.count() == 1) {
+                for (size_t b = 0; b < 256; ++b) {
+                    if (label.test(b)) return std::string(1, static_cast<char>(b));
+                }
+            }
+            return "[" + std::to_string(label.count()) + " bytes]";
+        }
     }
 }
 
 // NFA 的实现
 namespace lexer::regex {
-    // NFASate 构造函数
-    NFAState::NFAState(const bool is_accept) : is_accept(is_accept), id(nfa_state_id_counter++) {}
-
     // NFA 状态添加函数
-    NFAState *NFA::add_state(std::unique_ptr<NFAState> state) {
-        this->states.emplace_back(std::move(state));
-        return this->states.back().get();
+    int NFA::add_state(const bool is_accept) {
+        this->states.emplace_back();
+        this->states.back().is_accept = is_accept;
+        return static_cast<int>(this->states.size() - 1);
+    }
+
+    // 添加带标签的边
+    void NFA::add_transition(const int from, const CharSet &label, const int to) {
+        auto &state = this->states[from];
+        if (state.has_label()) {
+            throw std::logic_error("NFA state already has a labeled transition!");
+        }
+        state.label = label;
+        state.out = to;
+    }
+
+    // 添加 ε 边
+    void NFA::add_epsilon(const int from, const int to) {
+        auto &state = this->states[from];
+        if (state.epsilon[0] == NFAState::NONE) {
+            state.epsilon[0] = to;
+        } else if (state.epsilon[1] == NFAState::NONE) {
+            state.epsilon[1] = to;
+        } else {
+            throw std::logic_error("NFA state already has two epsilon transitions!");
+        }
     }
 
     // 调试用打印函数
     void NFA::print(const std::string &name) const {
         std::cout << "=== " << name << " Structure ===" << std::endl;
-        std::cout << "Start State: " << (start ? std::to_string(start->id) : "None") << std::endl;
+        std::cout << "Start State: " << (start != NFAState::NONE ? std::to_string(start) : "None") << std::endl;
         std::cout << "Accept States: ";
-        for (const auto &s: states) {
-            if (s->is_accept) std::cout << s->id << " ";
+        for (size_t i = 0; i < states.size(); ++i) {
+            if (states[i].is_accept) std::cout << i << " ";
         }
         std::cout << "\nTransitions:\n";
-        for (const auto &s: states) {
-            for (const auto &[c, targets]: s->transitions) {
-                std::string char_str = (c == EPSILON) ? "ε" : std::string(1, c);
-                for (const auto *t: targets) {
-                    std::cout << "  State " << s->id << " --" << char_str << "--> State " << t->id << std::endl;
-                }
+        for (size_t i = 0; i < states.size(); ++i) {
+            const auto &s = states[i];
+            if (s.has_label()) {
+                std::cout << "  State " << i << " --" << describe_label(s.label) << "--> State " << s.out << std::endl;
+            }
+            for (const int t: s.epsilon) {
+                if (t != NFAState::NONE) std::cout << "  State " << i << " --ε--> State " << t << std::endl;
             }
         }
         std::cout << "===========================\n" << std::endl;
@@ -78,81 +110,69 @@ namespace lexer::regex {
     }
 }
 
-// NFA 构建辅助函数
+// NFA 构建辅助函数，所有片段共享同一个 NFA 的状态数组
 namespace lexer::regex {
     namespace {
-        // 单个字符的构建：c
-        std::unique_ptr<NFA> create_char_nfa(const char c) {
-            auto nfa = std::make_unique<NFA>();
-            auto start = std::make_unique<NFAState>(false);
-            auto end = std::make_unique<NFAState>(false);
-            NFAState *startptr = nfa->add_state(std::move(start));
-            NFAState *endptr = nfa->add_state(std::move(end));
-            startptr->transitions[c].push_back(endptr);
-            nfa->start = startptr;
-            nfa->end = endptr;
-            return nfa;
-        }
-
-        // 连接的构建：ab
-        std::unique_ptr<NFA> create_concatenate_nfa(std::unique_ptr<NFA> &&a, std::unique_ptr<NFA> &&b) {
-            auto nfa = std::make_unique<NFA>();
-            // 转移动 a 和 b 的状态所有权到新的 NFA
-            std::move(a->states.begin(), a->states.end(), std::back_inserter(nfa->states));
-            std::move(b->states.begin(), b->states.end(), std::back_inserter(nfa->states));
-            // a 的接受状态 ->ε-> b 的起始状态，且 a 的接受状态失效
-            a->end->is_accept = false;
-            a->end->transitions[EPSILON].push_back(b->start);
-            // 新的 NFA 的起始/接受状态
-            nfa->start = a->start;
-            nfa->end = b->end;
-            return nfa;
+        // NFA 片段：起始状态与结束状态的下标
+        struct Fragment {
+            int start;
+            int end;
+        };
+
+        // 字节集合的构建：单个字符、字符类和 . 都只需一条带标签的边
+        Fragment create_char_nfa(NFA &nfa, const CharSet &chars) {
+            const int start = nfa.add_state();
+            const int end = nfa.add_state();
+            nfa.add_transition(start, chars, end);
+            return {start, end};
+        }
+
+        // 连接的构建：ab，a 的结束状态 ->ε-> b 的起始状态
+        Fragment create_concatenate_nfa(NFA &nfa, const Fragment a, const Fragment b) {
+            nfa.add_epsilon(a.end, b.start);
+            return {a.start, b.end};
         }
 
         // 选择的构建：a|b
-        std::unique_ptr<NFA> create_alternative_nfa(std::unique_ptr<NFA> &&a, std::unique_ptr<NFA> &&b) {
-            auto nfa = std::make_unique<NFA>();
+        Fragment create_alternative_nfa(NFA &nfa, const Fragment a, const Fragment b) {
             // 新的起始/接收状态
-            auto new_start = std::make_unique<NFAState>(false);
-            auto new_end = std::make_unique<NFAState>(true);
-            NFAState *startptr = nfa->add_state(std::move(new_start));
-            NFAState *endptr = nfa->add_state(std::move(new_end));
-            // 转移 a 和 b 的状态
-            std::move(a->states.begin(), a->states.end(), std::back_inserter(nfa->states));
-            std::move(b->states.begin(), b->states.end(), std::back_inserter(nfa->states));
-            // ε 转移：新的起始 -> a/b 的起始；a/b 的接受 -> 新的接受
-            startptr->transitions[EPSILON].push_back(a->start);
-            startptr->transitions[EPSILON].push_back(b->start);
-            a->end->is_accept = false;
-            b->end->is_accept = false;
-            a->end->transitions[EPSILON].push_back(endptr);
-            b->end->transitions[EPSILON].push_back(endptr);
-            // 绑定状态
-            nfa->start = startptr;
-            nfa->end = endptr;
-            return nfa;
+            const int start = nfa.add_state();
+            const int end = nfa.add_state();
+            // ε 转移：新的起始 -> a/b 的起始；a/b 的结束 -> 新的结束
+            nfa.add_epsilon(start, a.start);
+            nfa.add_epsilon(start, b.start);
+            nfa.add_epsilon(a.end, end);
+            nfa.add_epsilon(b.end, end);
+            return {start, end};
         }
 
         // 闭包的构建：a*
-        std::unique_ptr<NFA> create_kleene_closure(std::unique_ptr<NFA> &&a) {
-            auto nfa = std::make_unique<NFA>();
+        Fragment create_kleene_closure(NFA &nfa, const Fragment a) {
             // 新的起始/接受状态
-            auto new_start = std::make_unique<NFAState>(false);
-            auto new_end = std::make_unique<NFAState>(true);
-            NFAState *startptr = nfa->add_state(std::move(new_start));
-            NFAState *endptr = nfa->add_state(std::move(new_end));
-            // 转移 a 的状态
-            std::move(a->states.begin(), a->states.end(), std::back_inserter(nfa->states));
-            // ε 转移：新起始 -> a 的起始/新的接受；a 的接受 -> a 的起始/新的接受
-            startptr->transitions[EPSILON].push_back(a->start);
-            startptr->transitions[EPSILON].push_back(endptr);
-            a->end->is_accept = false;
-            a->end->transitions[EPSILON].push_back(a->start);
-            a->end->transitions[EPSILON].push_back(endptr);
-            // 绑定状态
-            nfa->start = startptr;
-            nfa->end = endptr;
-            return nfa;
+            const int start = nfa.add_state();
+            const int end = nfa.add_state();
+            // ε 转移：新起始 -> a 的起始/新的结束；a 的结束 -> a 的起始/新的结束
+            nfa.add_epsilon(start, a.start);
+            nfa.add_epsilon(start, end);
+            nfa.add_epsilon(a.end, a.start);
+            nfa.add_epsilon(a.end, end);
+            return {start, end};
+        }
+
+        // 正闭包的构建：a+，a 的结束 -> a 的起始/新的结束，不引入跳过 a 的路径
+        Fragment create_positive_closure(NFA &nfa, const Fragment a) {
+            const int end = nfa.add_state();
+            nfa.add_epsilon(a.end, a.start);
+            nfa.add_epsilon(a.end, end);
+            return {a.start, end};
+        }
+
+        // 可选的构建：a?，新起始 -> a 的起始/a 的结束
+        Fragment create_optional_nfa(NFA &nfa, const Fragment a) {
+            const int start = nfa.add_state();
+            nfa.add_epsilon(start, a.start);
+            nfa.add_epsilon(start, a.end);
+            return {start, a.end};
         }
     }
 }
@@ -160,53 +180,248 @@ namespace lexer::regex {
 // DFA 构建辅助函数
 namespace lexer::regex {
     namespace {
-        // TODO: 详细学习这个算法
-        // 1. 计算 DFA 的 ε 闭包
-        std::unordered_set<NFAState *> epsilon_closure(const std::unordered_set<NFAState *> &states) {
-            std::unordered_set<NFAState *> closure = states;
-            std::queue<NFAState *> q;
-            for (auto *s: states) q.push(s);
-            while (!q.empty()) {
-                auto *current = q.front();
-                q.pop();
-                // 遍历所有的 ε 转移
-                auto it = current->transitions.find(EPSILON);
-                if (it == current->transitions.end()) continue;
-                for (auto *next: it->second) {
-                    if (!closure.count(next)) {
-                        closure.insert(next);
-                        q.push(next);
-                    }
+        // 1. 由 NFA 状态集合创建 DFA 状态：含接受状态即为接受，规则取编号最小（优先级最高）者
+        std::unique_ptr<DFAState> make_dfa_state(const NFA &nfa, const StateSet &states) {
+            bool is_accept = false;
+            int rule = -1;
+            states.for_each([&](const size_t i) {
+                const auto &s = nfa.states[i];
+                if (!s.is_accept) return;
+                is_accept = true;
+                if (s.rule >= 0 && (rule < 0 || s.rule < rule)) {
+                    rule = s.rule;
+                }
+            });
+            auto state = std::make_unique<DFAState>(is_accept);
+            state->rule = rule;
+            return state;
+        }
+    }
+}
+
+// DFA 最小化辅助函数
+namespace lexer::regex {
+    namespace {
+        // Hopcroft 算法使用的分割细化结构：所有元素按块连续存放，块内被标记的元素移动到块的前部
+        class PartitionRefinement {
+        public:
+            static constexpr size_t NO_SPLIT = static_cast<size_t>(-1);
+
+            PartitionRefinement(const std::vector<size_t> &initial_block, const size_t block_count)
+                : elements(initial_block.size()), location(initial_block.size()), block(initial_block),
+                  first(block_count, 0), last(block_count, 0), marked(block_count, 0) {
+                // 计数排序，把同一块的元素放到一起
+                std::vector<size_t> sizes(block_count, 0);
+                for (const size_t b: initial_block) ++sizes[b];
+                for (size_t b = 1; b < block_count; ++b) this->first[b] = this->first[b - 1] + sizes[b - 1];
+                std::vector<size_t> fill(this->first);
+                for (size_t e = 0; e < initial_block.size(); ++e) {
+                    this->location[e] = fill[initial_block[e]]++;
+                    this->elements[this->location[e]] = e;
+                }
+                for (size_t b = 0; b < block_count; ++b) this->last[b] = this->first[b] + sizes[b];
+            }
+
+            [[nodiscard]] size_t block_count() const { return this->first.size(); }
+            [[nodiscard]] size_t block_of(const size_t element) const { return this->block[element]; }
+            [[nodiscard]] size_t size(const size_t b) const { return this->last[b] - this->first[b]; }
+
+            [[nodiscard]] std::vector<size_t>::const_iterator begin(const size_t b) const {
+                return this->elements.cbegin() + static_cast<long>(this->first[b]);
+            }
+
+            [[nodiscard]] std::vector<size_t>::const_iterator end(const size_t b) const {
+                return this->elements.cbegin() + static_cast<long>(this->last[b]);
+            }
+
+            // 标记元素，返回所在块是否是第一次被标记（用于收集被触及的块）
+            bool mark(const size_t element) {
+                const size_t b = this->block[element];
+                const size_t boundary = this->first[b] + this->marked[b];
+                const size_t loc = this->location[element];
+                if (loc < boundary) return false; // 已被标记
+                // 与标记区之后的第一个元素交换位置
+                const size_t other = this->elements[boundary];
+                std::swap(this->elements[loc], this->elements[boundary]);
+                this->location[other] = loc;
+                this->location[element] = boundary;
+                return this->marked[b]++ == 0;
+            }
+
+            // 把块中被标记的部分拆成新块，返回新块编号；全部或全不被标记时不拆分
+            size_t split(const size_t b) {
+                const size_t count = this->marked[b];
+                this->marked[b] = 0;
+                if (count == 0 || count == this->size(b)) return NO_SPLIT;
+                const size_t new_block = this->first.size();
+                this->first.push_back(this->first[b]);
+                this->last.push_back(this->first[b] + count);
+                this->marked.push_back(0);
+                this->first[b] += count;
+                for (size_t i = this->first[new_block]; i < this->last[new_block]; ++i) {
+                    this->block[this->elements[i]] = new_block;
                 }
+                return new_block;
             }
-            return closure;
+
+        private:
+            std::vector<size_t> elements; // 按块连续存放的元素
+            std::vector<size_t> location; // 元素在 elements 中的位置
+            std::vector<size_t> block;    // 元素所属的块
+            std::vector<size_t> first;    // 块在 elements 中的起始位置
+            std::vector<size_t> last;     // 块在 elements 中的结束位置（不含）
+            std::vector<size_t> marked;   // 块中被标记的元素数量
+        };
+    }
+}
+
+// 正则前端辅助函数
+namespace lexer::regex {
+    namespace {
+        // 判断是否为正则元字符，元字符的转义需要保留到词法分析阶段（- 与 ^ 仅在字符类中有特殊含义）
+        bool is_meta_char(const char c) {
+            static const std::string_view meta_chars = "*|()\\+?.[]{}^-";
+            return meta_chars.find(c) != std::string_view::npos;
+        }
+
+        // 单个字节的集合
+        CharSet single_char(const char c) {
+            CharSet set;
+            set.set(static_cast<unsigned char>(c));
+            return set;
         }
 
-        // TODO: 详细学习这个算法
-        // 2. 计算字符转移
-        std::unordered_set<NFAState *> move(const std::unordered_set<NFAState *> &states, char c) {
-            std::unordered_set<NFAState *> result;
-            for (auto *s: states) {
-                auto it = s->transitions.find(c);
-                if (it != s->transitions.end()) {
-                    for (auto *next: it->second) {
-                        result.insert(next);
+        // 读取字符类中的一个字符，处理 \x 形式的转义
+        char read_class_char(const std::string_view regex, size_t &i) {
+            if (regex[i] == '\\' && i + 1 < regex.size()) ++i;
+            return regex[i++];
+        }
+
+        // 解析字符类 [...]：支持 a-z 形式的范围和 ^ 取反，紧跟 [ 或 [^ 的 ] 按普通字符处理
+        // 进入时 i 指向 '['，返回时 i 指向对应的 ']'
+        CharSet parse_char_class(const std::string_view regex, size_t &i) {
+            size_t j = i + 1;
+            bool negate = false;
+            if (j < regex.size() && regex[j] == '^') {
+                negate = true;
+                ++j;
+            }
+            CharSet set;
+            for (bool first = true;; first = false) {
+                if (j >= regex.size()) {
+                    throw std::invalid_argument("Unterminated character class (missing ']')");
+                }
+                if (regex[j] == ']' && !first) break;
+                const char low = read_class_char(regex, j);
+                // 末尾的 - 按普通字符处理，例如 [a-]
+                if (j + 1 < regex.size() && regex[j] == '-' && regex[j + 1] != ']') {
+                    ++j;
+                    const char high = read_class_char(regex, j);
+                    if (static_cast<unsigned char>(low) > static_cast<unsigned char>(high)) {
+                        throw std::invalid_argument("Invalid range in character class");
+                    }
+                    for (size_t b = static_cast<unsigned char>(low); b <= static_cast<unsigned char>(high); ++b) {
+                        set.set(b);
                     }
+                } else {
+                    set.set(static_cast<unsigned char>(low));
+                }
+            }
+            i = j;
+            return negate ? ~set : set;
+        }
+
+        // 解析重复次数 {m}、{m,}、{m,n}，max 为 -1 表示无上限
+        // 进入时 i 指向 '{'，返回时 i 指向对应的 '}'
+        std::pair<int, int> parse_repetition(const std::string_view regex, size_t &i) {
+            const auto read_number = [&regex](size_t &j) {
+                int value = -1;
+                while (j < regex.size() && regex[j] >= '0' && regex[j] <= '9') {
+                    value = (value < 0 ? 0 : value * 10) + (regex[j++] - '0');
+                    if (value > 1000) throw std::invalid_argument("Repetition count is too large");
+                }
+                return value;
+            };
+            size_t j = i + 1;
+            const int min = read_number(j);
+            int max = min;
+            if (j < regex.size() && regex[j] == ',') {
+                ++j;
+                max = read_number(j);
+            }
+            if (min < 0 || j >= regex.size() || regex[j] != '}') {
+                throw std::invalid_argument("Invalid repetition (expected {m}, {m,} or {m,n})");
+            }
+            if (max >= 0 && max < min) {
+                throw std::invalid_argument("Invalid repetition (max is less than min)");
+            }
+            if (max == 0) {
+                throw std::invalid_argument("Empty repetition {0} is not supported");
+            }
+            i = j;
+            return {min, max};
+        }
+
+        // 找到 Token 列表末尾操作数的起始下标：单个 CHAR 或括号分组，连同其后的后缀运算符
+        size_t last_operand_begin(const std::vector<Token> &tokens) {
+            size_t i = tokens.size();
+            while (i > 0 && (tokens[i - 1].type == TokenType::STAR || tokens[i - 1].type == TokenType::PLUS ||
+                             tokens[i - 1].type == TokenType::QUESTION)) {
+                --i;
+            }
+            if (i > 0 && tokens[i - 1].type == TokenType::CHAR) return i - 1;
+            if (i > 0 && tokens[i - 1].type == TokenType::RPAREN) {
+                int depth = 0;
+                while (i > 0) {
+                    --i;
+                    if (tokens[i].type == TokenType::RPAREN) ++depth;
+                    if (tokens[i].type == TokenType::LPAREN && --depth == 0) return i;
                 }
             }
-            return result;
+            throw std::invalid_argument("Repetition needs an operand");
+        }
+
+        // 展开后 Token 数量的上限，嵌套重复（如 (a{1000}){1000}）会按乘积增长，超过上限直接拒绝
+        constexpr size_t MAX_EXPANDED_TOKENS = 1 << 16;
+
+        // 在 Token 层面展开重复：a{2,4} -> a a a? a?，a{2,} -> a a a*
+        void expand_repetition(std::vector<Token> &tokens, const int min, const int max) {
+            const size_t begin = last_operand_begin(tokens);
+            const size_t copies = static_cast<size_t>(max < 0 ? min + 1 : max);
+            // 每份副本最多额外带一个 CONCAT 和一个后缀运算符
+            if (begin + copies * (tokens.size() - begin + 2) > MAX_EXPANDED_TOKENS) {
+                throw std::invalid_argument("Repetition expands beyond the token limit");
+            }
+            const std::vector<Token> operand(tokens.begin() + static_cast<long>(begin), tokens.end());
+            tokens.resize(begin);
+            const auto append = [&]() {
+                if (tokens.size() > begin) tokens.push_back({TokenType::CONCAT, {}});
+                tokens.insert(tokens.end(), operand.begin(), operand.end());
+            };
+            for (int i = 0; i < min; ++i) append();
+            if (max < 0) {
+                append();
+                tokens.push_back({TokenType::STAR, {}});
+                return;
+            }
+            for (int i = min; i < max; ++i) {
+                append();
+                tokens.push_back({TokenType::QUESTION, {}});
+            }
         }
     }
 }
 
 // 核心功能函数实现
 namespace lexer::regex {
-    // 预处理转义字符
+    // 预处理转义字符：普通字符的转义直接去掉反斜杠，元字符的转义保留给词法分析处理
     std::string preprocess_regex(const std::string_view &raw_regex) {
         std::string processed;
         for (size_t i = 0; i < raw_regex.size(); ++i) {
             if (raw_regex[i] == '\\' && i + 1 < raw_regex.size()) {
-                processed += raw_regex[++i];
+                const char escaped = raw_regex[++i];
+                if (is_meta_char(escaped)) processed += '\\';
+                processed += escaped;
             } else {
                 processed += raw_regex[i];
             }
@@ -221,65 +436,101 @@ namespace lexer::regex {
     std::vector<Token> lexer(const std::string_view processed_regex) {
         std::vector<Token> tokens;
         const size_t length = processed_regex.size();
+        // 插入隐含连接符：前一个 Token 能结束一个操作数（字符/后缀运算符/右括号）时才需要连接
+        const auto push_operand_start = [&tokens](const Token &token) {
+            if (!tokens.empty()) {
+                const TokenType prev = tokens.back().type;
+                if (prev == TokenType::CHAR || prev == TokenType::STAR || prev == TokenType::RPAREN ||
+                    prev == TokenType::PLUS || prev == TokenType::QUESTION) {
+                    tokens.push_back({TokenType::CONCAT, {}});
+                }
+            }
+            tokens.push_back(token);
+        };
         for (std::size_t i = 0; i < length; ++i) {
             const char c = processed_regex[i];
             switch (c) {
                 case '*':
-                    tokens.push_back({TokenType::STAR, '\0'});
+                    tokens.push_back({TokenType::STAR, {}});
                     break;
+                case '+':
+                    tokens.push_back({TokenType::PLUS, {}});
+                    break;
+                case '?':
+                    tokens.push_back({TokenType::QUESTION, {}});
+                    break;
+                case '{': {
+                    const auto [min, max] = parse_repetition(processed_regex, i);
+                    expand_repetition(tokens, min, max);
+                    break;
+                }
                 case '|':
-                    tokens.push_back({TokenType::OR, '\0'});
+                    tokens.push_back({TokenType::OR, {}});
                     break;
                 case '(':
-                    tokens.push_back({TokenType::LPAREN, '\0'});
+                    push_operand_start({TokenType::LPAREN, {}});
                     break;
                 case ')':
-                    tokens.push_back({TokenType::RPAREN, '\0'});
+                    tokens.push_back({TokenType::RPAREN, {}});
                     break;
-                default:
-                    // 隐含字符（允许字母、数字、标点和空格等）
-                    tokens.push_back({TokenType::CHAR, c});
-                    // 自动插入隐含连接符号（例如 "ab" -> "a.CONCAT.b"）
+                case '[':
+                    push_operand_start({TokenType::CHAR, parse_char_class(processed_regex, i)});
+                    break;
+                case '.':
+                    // . 匹配除换行符以外的任意字节
+                    push_operand_start({TokenType::CHAR, ~single_char('\n')});
+                    break;
+                case '\\':
+                    // 转义的元字符按普通字符处理，例如 \* -> '*'
                     if (i + 1 < length) {
-                        const char next_c = processed_regex[i + 1];
-                        if (std::isalnum(next_c) || next_c == '(' || next_c == '\\') {
-                            tokens.push_back({TokenType::CONCAT, '\0'});
-                        }
+                        push_operand_start({TokenType::CHAR, single_char(processed_regex[++i])});
+                    } else {
+                        push_operand_start({TokenType::CHAR, single_char(c)});
                     }
                     break;
+                default:
+                    // 普通字符（允许字母、数字、标点和空格等）
+                    push_operand_start({TokenType::CHAR, single_char(c)});
+                    break;
             }
         }
         return tokens;
     }
 
     // 语法分析：Token 列表 -> 后缀表达式，调度场算法
-    std::string infix_to_postfix(const std::vector<Token> &tokens) {
-        std::string postfix;
+    std::vector<Token> infix_to_postfix(const std::vector<Token> &tokens) {
+        std::vector<Token> postfix;
+        postfix.reserve(tokens.size());
         std::stack<TokenType> op_stack;
-        // 运算法优先级：STAR(3) > CONCAT(2) > OR(1)
+        // 运算法优先级：STAR/PLUS/QUESTION(3) > CONCAT(2) > OR(1)
         const std::unordered_map<TokenType, int> precedence = {
             {TokenType::STAR, 3},
+            {TokenType::PLUS, 3},
+            {TokenType::QUESTION, 3},
             {TokenType::CONCAT, 2},
             {TokenType::OR, 1},
         };
-        for (const auto &[type, value]: tokens) {
-            switch (type) {
-                // 1. 普通字符：直接加入到后缀表达式
+        const auto pop_operator = [&]() {
+            postfix.push_back({op_stack.top(), {}});
+            op_stack.pop();
+        };
+        for (const auto &token: tokens) {
+            switch (token.type) {
+                // 1. 字节集合：直接加入到后缀表达式
                 case TokenType::CHAR: {
-                    postfix += value;
+                    postfix.push_back(token);
                     break;
                 }
                 // 2. 左括号：直接入栈，不参与优先级比较
                 case TokenType::LPAREN: {
-                    op_stack.push(type);
+                    op_stack.push(token.type);
                     break;
                 }
                 // 3. 右括号：弹出元素并添加到后缀表达式直到遇到左括号才停止
                 case TokenType::RPAREN: {
                     // 直到弹出左括号
                     while (!op_stack.empty() && op_stack.top() != TokenType::LPAREN) {
-                        postfix += static_cast<char>(op_stack.top());
-                        op_stack.pop();
+                        pop_operator();
                     }
                     if (op_stack.empty()) {
                         throw std::invalid_argument("Mismatched parenthese (missing '(')");
@@ -288,17 +539,18 @@ namespace lexer::regex {
                     op_stack.pop();
                     break;
                 }
-                // 4. 普通运算符：(STAR/CONCAT/OR)：按优先级弹出
+                // 4. 普通运算符：(STAR/PLUS/QUESTION/CONCAT/OR)：按优先级弹出
                 case TokenType::STAR:
+                case TokenType::PLUS:
+                case TokenType::QUESTION:
                 case TokenType::CONCAT:
                 case TokenType::OR: {
                     // 弹出优先级 >= 当前运算符
                     while (!op_stack.empty() && op_stack.top() != TokenType::LPAREN &&
-                           precedence.at(op_stack.top()) >= precedence.at(type)) {
-                        postfix += static_cast<char>(op_stack.top());
-                        op_stack.pop();
+                           precedence.at(op_stack.top()) >= precedence.at(token.type)) {
+                        pop_operator();
                     }
-                    op_stack.push(type);
+                    op_stack.push(token.type);
                     break;
                 }
             }
@@ -308,196 +560,378 @@ namespace lexer::regex {
             if (op_stack.top() == TokenType::LPAREN) {
                 throw std::invalid_argument("Mismatched parenthese (missing ')')");
             }
-            postfix += static_cast<char>(op_stack.top());
-            op_stack.pop();
+            pop_operator();
         }
         return postfix;
     }
 
-    // NFA 构建：后缀表达式 -> NFA
-    std::unique_ptr<NFA> build_nfa(const std::string &postfix) {
-        std::stack<std::unique_ptr<NFA> > nfa_stack;
-        for (const char c: postfix) {
-            switch (static_cast<TokenType>(c)) {
-                // 闭包处理
-                case TokenType::STAR: {
-                    if (nfa_stack.empty()) {
-                        throw std::invalid_argument("Invalid postfix: STAR needs 1 operand!");
+    // NFA 构建：后缀表达式 -> NFA，所有状态一次性预留在同一个数组中
+    std::unique_ptr<NFA> build_nfa(const std::vector<Token> &postfix) {
+        auto nfa = std::make_unique<NFA>();
+        // 每个字符/选择/闭包至多新增两个状态，连接不新增状态
+        nfa->states.reserve(postfix.size() * 2);
+        std::vector<Fragment> fragment_stack;
+        fragment_stack.reserve(postfix.size());
+        const auto pop = [&fragment_stack]() {
+            const Fragment top = fragment_stack.back();
+            fragment_stack.pop_back();
+            return top;
+        };
+        for (const auto &token: postfix) {
+            switch (token.type) {
+                // 闭包、正闭包与可选处理
+                case TokenType::STAR:
+                case TokenType::PLUS:
+                case TokenType::QUESTION: {
+                    if (fragment_stack.empty()) {
+                        throw std::invalid_argument("Invalid postfix: STAR/PLUS/QUESTION needs 1 operand!");
+                    }
+                    const Fragment a = pop();
+                    if (token.type == TokenType::STAR) {
+                        fragment_stack.push_back(create_kleene_closure(*nfa, a));
+                    } else if (token.type == TokenType::PLUS) {
+                        fragment_stack.push_back(create_positive_closure(*nfa, a));
+                    } else {
+                        fragment_stack.push_back(create_optional_nfa(*nfa, a));
                     }
-                    auto a = std::move(nfa_stack.top());
-                    nfa_stack.pop();
-                    nfa_stack.push(create_kleene_closure(std::move(a)));
                     break;
                 }
                 case TokenType::CONCAT: {
-                    if (nfa_stack.size() < 2) {
+                    if (fragment_stack.size() < 2) {
                         throw std::invalid_argument("Invalid postfix: CONCAT needs 2 operands!");
                     }
-                    auto b = std::move(nfa_stack.top());
-                    nfa_stack.pop();
-                    auto a = std::move(nfa_stack.top());
-                    nfa_stack.pop();
-                    nfa_stack.push(create_concatenate_nfa(std::move(a), std::move(b)));
+                    const Fragment b = pop();
+                    const Fragment a = pop();
+                    fragment_stack.push_back(create_concatenate_nfa(*nfa, a, b));
                     break;
                 }
                 case TokenType::OR: {
-                    if (nfa_stack.size() < 2) {
+                    if (fragment_stack.size() < 2) {
                         throw std::invalid_argument("Invalid postfix: OR needs 2 operands!");
                     }
-                    auto b = std::move(nfa_stack.top());
-                    nfa_stack.pop();
-                    auto a = std::move(nfa_stack.top());
-                    nfa_stack.pop();
-                    nfa_stack.push(create_alternative_nfa(std::move(a), std::move(b)));
+                    const Fragment b = pop();
+                    const Fragment a = pop();
+                    fragment_stack.push_back(create_alternative_nfa(*nfa, a, b));
                     break;
                 }
-                default: {
-                    nfa_stack.push(create_char_nfa(c));
+                case TokenType::CHAR: {
+                    fragment_stack.push_back(create_char_nfa(*nfa, token.chars));
                     break;
                 }
+                default: {
+                    throw std::invalid_argument("Invalid postfix: unexpected parenthese");
+                }
             }
         }
-        if (nfa_stack.size() != 1) {
+        if (fragment_stack.size() != 1) {
             throw std::invalid_argument("Invalid postfix: mismatched operands/operators");
         }
-        return std::move(nfa_stack.top());
+        // 整个表达式的结束状态即为接受状态
+        nfa->start = fragment_stack.back().start;
+        nfa->end = fragment_stack.back().end;
+        nfa->states[nfa->end].is_accept = true;
+        return nfa;
+    }
+
+    // 完整前端：原始正则 -> NFA
+    std::unique_ptr<NFA> regex_to_nfa(const std::string_view raw_regex) {
+        return build_nfa(infix_to_postfix(lexer(preprocess_regex(raw_regex))));
+    }
+
+    // 多规则合并：所有规则的状态复制到同一数组，由一串分支状态通过 ε 转移连接各规则的起始状态
+    std::unique_ptr<NFA> combine_rules(std::vector<std::unique_ptr<NFA> > &&rules) {
+        if (rules.empty()) {
+            throw std::invalid_argument("Cannot combine an empty rule list!");
+        }
+        size_t total = rules.size();
+        for (const auto &rule: rules) {
+            if (!rule || rule->start == NFAState::NONE || rule->end == NFAState::NONE) {
+                throw std::invalid_argument("Cannot combine an invalid rule NFA!");
+            }
+            total += rule->states.size();
+        }
+        auto nfa = std::make_unique<NFA>();
+        nfa->states.reserve(total);
+        // 分支链：branch_i ->ε-> 规则 i 的起始状态，branch_i ->ε-> branch_{i+1}
+        int branch = nfa->add_state();
+        nfa->start = branch;
+        for (size_t i = 0; i < rules.size(); ++i) {
+            const auto &rule = *rules[i];
+            const int offset = static_cast<int>(nfa->states.size());
+            for (NFAState state: rule.states) {
+                if (state.has_label()) state.out += offset;
+                for (int &t: state.epsilon) {
+                    if (t != NFAState::NONE) t += offset;
+                }
+                nfa->states.push_back(state);
+            }
+            // 规则的接受状态记录规则编号，保留其接受性
+            auto &accept = nfa->states[rule.end + offset];
+            accept.is_accept = true;
+            accept.rule = static_cast<int>(i);
+            nfa->add_epsilon(branch, rule.start + offset);
+            if (i + 1 < rules.size()) {
+                const int next_branch = nfa->add_state();
+                nfa->add_epsilon(branch, next_branch);
+                branch = next_branch;
+            }
+        }
+        // 合并后的 NFA 没有唯一的接受状态
+        nfa->end = NFAState::NONE;
+        return nfa;
+    }
+
+    // ε 闭包：深度优先遍历，每个状态只计算一次
+    std::vector<std::vector<uint32_t> > epsilon_closures(const NFA &nfa) {
+        const size_t n = nfa.states.size();
+        std::vector<std::vector<uint32_t> > closures(n);
+        StateSet visited(n);
+        std::vector<uint32_t> stack;
+        for (uint32_t i = 0; i < n; ++i) {
+            visited.clear();
+            visited.insert(i);
+            stack.assign(1, i);
+            auto &closure = closures[i];
+            while (!stack.empty()) {
+                const uint32_t current = stack.back();
+                stack.pop_back();
+                closure.push_back(current);
+                for (const int next: nfa.states[current].epsilon) {
+                    if (next != NFAState::NONE && !visited.contains(next)) {
+                        visited.insert(next);
+                        stack.push_back(static_cast<uint32_t>(next));
+                    }
+                }
+            }
+            std::sort(closure.begin(), closure.end());
+        }
+        return closures;
+    }
+
+    // 字节等价类：每个不同的标签集合把已有的类按是否属于该集合再细分一次
+    ByteClasses compute_byte_classes(const NFA &nfa) {
+        std::array<int, 256> class_of{};
+        int class_count = 1;
+        std::unordered_set<CharSet> seen;
+        // refined[class * 2 + in_label] -> 细分后的类编号
+        std::vector<int> refined;
+        for (const auto &s: nfa.states) {
+            if (!s.has_label() || !seen.insert(s.label).second) continue;
+            refined.assign(static_cast<size_t>(class_count) * 2, -1);
+            int refined_count = 0;
+            for (size_t b = 0; b < 256; ++b) {
+                int &slot = refined[static_cast<size_t>(class_of[b]) * 2 + s.label.test(b)];
+                if (slot < 0) slot = refined_count++;
+                class_of[b] = slot;
+            }
+            class_count = refined_count;
+        }
+        ByteClasses classes;
+        for (size_t b = 0; b < 256; ++b) classes.map[b] = static_cast<uint8_t>(class_of[b]);
+        classes.count = static_cast<uint16_t>(class_count);
+        return classes;
     }
 
-    // DFA 构建: NFA -> DFA ，NFA 所有权转移到 DFA
-    std::unique_ptr<DFA> build_dfa(const std::unique_ptr<NFA> &nfa) {
+    // DFA 构建: NFA -> DFA，子集构造，NFA 状态集合用位集表示
+    std::unique_ptr<DFA> build_dfa(const std::unique_ptr<NFA> &nfa, std::vector<StateSet> *rule_sets) {
         auto dfa = std::make_unique<DFA>();
-        if (!nfa || !nfa->start) {
+        if (!nfa || nfa->start == NFAState::NONE) {
             throw std::invalid_argument("Cannot build DFA from invalid NFA!");
         }
-        // 1. 初始状态：NFA 起始状态的 ε 闭包
-        const auto initial_nfa_states = epsilon_closure({nfa->start});
-        // 2. 创建 DFA 初始状态，判断是否为接受状态
-        bool is_initial_accept = false;
-        for (const auto *s: initial_nfa_states) {
-            if (s->is_accept) {
-                is_initial_accept = true;
-                break;
-            }
-        }
-        auto initial_dfa_state = std::make_unique<DFAState>(is_initial_accept);
-        DFAState *initial_dfa_ptr = dfa->add_state(std::move(initial_dfa_state));
-        dfa->state_map[initial_nfa_states] = initial_dfa_ptr;
-        dfa->start = initial_dfa_ptr;
-        // 3. 广度优先处理所有的 DFA 状态
-        std::queue<std::unordered_set<NFAState *> > state_queue;
-        state_queue.push(initial_nfa_states);
-        while (!state_queue.empty()) {
-            const auto current_nfs_states = state_queue.front();
-            state_queue.pop();
-            auto *current_dfa_state = dfa->state_map.at(current_nfs_states);
-            // 收集所有的非 ε 转移的字符，去重
-            std::unordered_set<char> input_chars;
-            for (auto *s: current_nfs_states) {
-                for (const auto &[c,_]: s->transitions) {
-                    if (c != EPSILON) {
-                        input_chars.insert(c);
-                    }
+        const size_t n = nfa->states.size();
+        const auto closures = epsilon_closures(*nfa);
+        // 需要输出规则集合时，位集的宽度为最大规则编号 + 1
+        size_t rule_count = 0;
+        if (rule_sets) {
+            rule_sets->clear();
+            for (const NFAState &state: nfa->states) {
+                if (state.is_accept && state.rule >= 0) {
+                    rule_count = std::max(rule_count, static_cast<size_t>(state.rule) + 1);
+                }
+            }
+        }
+        // 已发现的状态集合 -> DFA 状态下标
+        std::unordered_map<StateSet, size_t, StateSetHash> state_map;
+        std::vector<StateSet> subsets;
+        const auto find_or_add = [&](StateSet &&set) {
+            const auto [it, inserted] = state_map.emplace(set, subsets.size());
+            if (inserted) {
+                dfa->add_state(make_dfa_state(*nfa, set));
+                if (rule_sets) {
+                    StateSet &rules = rule_sets->emplace_back(rule_count);
+                    set.for_each([&](const size_t i) {
+                        const NFAState &state = nfa->states[i];
+                        if (state.is_accept && state.rule >= 0) rules.insert(static_cast<size_t>(state.rule));
+                    });
                 }
+                subsets.push_back(std::move(set));
             }
-            // 处理每个字符的转移
-            for (const char c: input_chars) {
-                const auto move_result = move(current_nfs_states, c);
-                const auto next_nfa_states = epsilon_closure(move_result);
-                // 若状态集合不存在，则创建新的 DFA 状态
-                if (!dfa->state_map.count(next_nfa_states)) {
-                    bool is_accept = false;
-                    for (auto *s: next_nfa_states) {
-                        if (s->is_accept) {
-                            is_accept = true;
-                            break;
-                        }
+            return it->second;
+        };
+        // 1. 初始状态：NFA 起始状态的 ε 闭包
+        StateSet initial(n);
+        for (const uint32_t i: closures[nfa->start]) initial.insert(i);
+        find_or_add(std::move(initial));
+        dfa->start = dfa->states.front().get();
+        // 2. 以 NFA 的字节等价类为字母表：记录每个类包含的字节，以及每条带标签边覆盖的类
+        const ByteClasses nfa_classes = compute_byte_classes(*nfa);
+        std::vector<std::vector<unsigned char> > class_bytes(nfa_classes.count);
+        for (size_t b = 0; b < 256; ++b) class_bytes[nfa_classes.map[b]].push_back(static_cast<unsigned char>(b));
+        std::vector<std::vector<uint16_t> > label_classes(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (!nfa->states[i].has_label()) continue;
+            for (uint16_t c = 0; c < nfa_classes.count; ++c) {
+                if (nfa->states[i].label.test(class_bytes[c].front())) label_classes[i].push_back(c);
+            }
+        }
+        // 3. 按发现顺序处理所有的 DFA 状态，每个字节类的后继集合在一次遍历中累积
+        std::vector<int> slot_of(nfa_classes.count, -1);
+        std::vector<StateSet> next_sets;
+        std::vector<uint16_t> input_classes;
+        for (size_t current = 0; current < subsets.size(); ++current) {
+            input_classes.clear();
+            subsets[current].for_each([&](const size_t i) {
+                for (const uint16_t c: label_classes[i]) {
+                    if (slot_of[c] < 0) {
+                        slot_of[c] = static_cast<int>(input_classes.size());
+                        if (next_sets.size() <= input_classes.size()) next_sets.emplace_back(n);
+                        next_sets[input_classes.size()].clear();
+                        input_classes.push_back(c);
                     }
-                    auto new_dfa_state = std::make_unique<DFAState>(is_accept);
-                    DFAState *new_dfa_ptr = dfa->add_state(std::move(new_dfa_state));
-                    dfa->state_map[next_nfa_states] = new_dfa_ptr;
-                    state_queue.push(next_nfa_states);
+                    auto &next = next_sets[slot_of[c]];
+                    for (const uint32_t j: closures[nfa->states[i].out]) next.insert(j);
+                }
+            });
+            // 绑定 DFA 转移，类中的每个字节指向同一目标，状态集合不存在时创建新的 DFA 状态
+            for (size_t k = 0; k < input_classes.size(); ++k) {
+                const uint16_t c = input_classes[k];
+                slot_of[c] = -1;
+                const size_t target = find_or_add(StateSet(next_sets[k]));
+                for (const unsigned char byte: class_bytes[c]) {
+                    dfa->states[current]->transitions[static_cast<char>(byte)] = dfa->states[target].get();
                 }
-                // 绑定 DFA 转移
-                current_dfa_state->transitions[c] = dfa->state_map.at(next_nfa_states);
             }
         }
+        dfa->byte_classes = compute_byte_classes(*dfa);
         return dfa;
     }
 
-    // DFA 最小化：原始 DFA -> 最小 DFA，分割法实现
+    // DFA 最小化：原始 DFA -> 最小 DFA，Hopcroft 分割细化实现，复杂度 O(n·k·log n)
     std::unique_ptr<DFA> minimize_dfa(const DFA &original_dfa) {
-        // 1. 初始分割，接受/非接收状态
-        std::vector<std::unordered_set<DFAState *> > partitions;
-        std::unordered_set<DFAState *> accept_part, non_accept_part;
-        for (const auto &s_ptr: original_dfa.states) {
-            auto *s = s_ptr.get();
-            (s->is_accept ? accept_part : non_accept_part).insert(s);
-        }
-        if (!accept_part.empty()) partitions.push_back(accept_part);
-        if (!non_accept_part.empty()) partitions.push_back(non_accept_part);
-        // 2. 迭代分割直到稳定下来
-        bool changed = true;
-        while (changed) {
-            changed = false;
-            std::vector<std::unordered_set<DFAState *> > new_partitions;
-            for (const auto &part: partitions) {
-                if (part.size() <= 1) {
-                    new_partitions.push_back(part);
-                    continue;
+        auto min_dfa = std::make_unique<DFA>();
+        const size_t n = original_dfa.states.size();
+        if (n == 0 || !original_dfa.start) return min_dfa;
+        // 1. 状态编号，以字节等价类为字母表构建完全转移表，缺失的转移指向额外的死状态 n
+        std::unordered_map<const DFAState *, size_t> index;
+        for (size_t i = 0; i < n; ++i) index[original_dfa.states[i].get()] = i;
+        const ByteClasses classes = compute_byte_classes(original_dfa);
+        const size_t k = classes.count;
+        const size_t dead = n;
+        std::vector<size_t> delta((n + 1) * k, dead);
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto &[c, target]: original_dfa.states[i]->transitions) {
+                delta[i * k + classes.of(c)] = index.at(target);
+            }
+        }
+        // 2. 初始分割：接受状态按规则编号分组，非接受状态（含死状态）为一组
+        std::vector<size_t> initial_block(n + 1);
+        std::map<std::pair<bool, int>, size_t> initial_ids;
+        for (size_t i = 0; i <= n; ++i) {
+            const DFAState *s = i < n ? original_dfa.states[i].get() : nullptr;
+            const auto key = s && s->is_accept ? std::make_pair(true, s->rule) : std::make_pair(false, -1);
+            initial_block[i] = initial_ids.emplace(key, initial_ids.size()).first->second;
+        }
+        PartitionRefinement partition(initial_block, initial_ids.size());
+        // 3. 逆转移索引：inverse[(t * k + c)] 为经字节类 c 转移到 t 的所有状态
+        std::vector<size_t> inverse_offsets((n + 1) * k + 1, 0);
+        for (size_t s = 0; s <= n; ++s) {
+            for (size_t c = 0; c < k; ++c) ++inverse_offsets[delta[s * k + c] * k + c + 1];
+        }
+        for (size_t i = 1; i < inverse_offsets.size(); ++i) inverse_offsets[i] += inverse_offsets[i - 1];
+        std::vector<size_t> inverse(inverse_offsets.back());
+        std::vector<size_t> fill(inverse_offsets.begin(), inverse_offsets.end() - 1);
+        for (size_t s = 0; s <= n; ++s) {
+            for (size_t c = 0; c < k; ++c) inverse[fill[delta[s * k + c] * k + c]++] = s;
+        }
+        // 4. 工作表初始化：除最大的初始块以外，所有 (块, 字节类) 作为分割器
+        std::vector<std::pair<size_t, size_t> > worklist;
+        std::vector<bool> in_worklist;
+        const auto push_splitter = [&](const size_t block, const size_t c) {
+            if (in_worklist.size() < (block + 1) * k) in_worklist.resize((block + 1) * k, false);
+            if (in_worklist[block * k + c]) return;
+            in_worklist[block * k + c] = true;
+            worklist.emplace_back(block, c);
+        };
+        size_t largest = 0;
+        for (size_t b = 1; b < partition.block_count(); ++b) {
+            if (partition.size(b) > partition.size(largest)) largest = b;
+        }
+        for (size_t b = 0; b < partition.block_count(); ++b) {
+            if (b == largest) continue;
+            for (size_t c = 0; c < k; ++c) push_splitter(b, c);
+        }
+        // 5. 迭代细分：取出分割器 (A, c)，用 A 在字节类 c 上的前驱集合细分所有块
+        std::vector<size_t> splitter_states;
+        std::vector<size_t> touched;
+        while (!worklist.empty()) {
+            const auto [splitter, c] = worklist.back();
+            worklist.pop_back();
+            in_worklist[splitter * k + c] = false;
+            // 先复制 A 的成员，细分过程中 A 本身也可能被拆开
+            splitter_states.assign(partition.begin(splitter), partition.end(splitter));
+            touched.clear();
+            for (const size_t t: splitter_states) {
+                for (size_t i = inverse_offsets[t * k + c]; i < inverse_offsets[t * k + c + 1]; ++i) {
+                    if (partition.mark(inverse[i])) touched.push_back(partition.block_of(inverse[i]));
                 }
-                // 按照转移特征分组。同一组转移目标属于同一分区
-                std::unordered_map<std::string, std::unordered_set<DFAState *> > groups;
-                for (auto *s: part) {
-                    // 生成转移特征键，字符+目标分区索引，排序保持一致
-                    std::vector<char> chars;
-                    for (const auto &[c,_]: s->transitions) chars.push_back(c);
-                    std::sort(chars.begin(), chars.end());
-                    std::string key;
-                    for (const char c: chars) {
-                        auto *target = s->transitions.at(c);
-                        // 查找目标状态所属分区索引
-                        for (size_t i = 0; i < partitions.size(); ++i) {
-                            if (partitions[i].count(target)) {
-                                key += c + std::to_string(i) + ",";
-                                break;
-                            }
-                        }
+            }
+            for (const size_t block: touched) {
+                const size_t new_block = partition.split(block);
+                if (new_block == PartitionRefinement::NO_SPLIT) continue;
+                // 已在工作表中的块，两部分都要处理；否则只需加入较小的一部分
+                for (size_t d = 0; d < k; ++d) {
+                    if (block * k + d < in_worklist.size() && in_worklist[block * k + d]) {
+                        push_splitter(new_block, d);
+                    } else {
+                        push_splitter(partition.size(new_block) <= partition.size(block) ? new_block : block, d);
                     }
-                    groups[key].insert(s);
-                }
-                // 更新分区。若分组变化则标记 changed
-                for (const auto &[_,group]: groups) {
-                    new_partitions.push_back(group);
-                    if (group.size() != part.size()) changed = true;
                 }
             }
-            partitions = std::move(new_partitions);
         }
-        // 3. 构建最小 DFA
-        auto min_dfa = std::make_unique<DFA>();
-        // 原始状态 -> 最小状态映射
-        std::unordered_map<DFAState *, DFAState *> state_map;
-        // 创建最小 DFA 状态，取每一个分区的第一个状态为代表
-        for (const auto &part: partitions) {
-            auto *original_rep = *part.begin();
-            // 新状态的接受性与代表一致
-            auto new_state = std::make_unique<DFAState>(original_rep->is_accept);
-            DFAState *new_state_ptr = min_dfa->add_state(std::move(new_state));
-            // 映射分区内所有状态到新状态
-            for (auto *s: part) state_map[s] = new_state_ptr;
-            // 绑定最小 DFA 的起始状态
-            if (original_rep == original_dfa.start) {
-                min_dfa->start = new_state_ptr;
-            }
-        }
-        // 构建最小 DFA 的转移，复制代表状态的转移
-        for (const auto &part: partitions) {
-            auto *original_rep = *part.begin();
-            auto *min_state = state_map.at(original_rep);
-            for (const auto &[c,original_target]: original_rep->transitions) {
-                min_state->transitions[c] = state_map.at(original_target);
+        // 6. 构建最小 DFA：从起始块出发按广度优先编号，丢弃死状态所在的块
+        const size_t dead_block = partition.block_of(dead);
+        std::vector<DFAState *> block_state(partition.block_count(), nullptr);
+        std::queue<size_t> pending;
+        const auto state_of_block = [&](const size_t block) {
+            if (!block_state[block]) {
+                // 死状态只会出现在死状态块中，其余块的代表都是原 DFA 的状态
+                const DFAState *rep = original_dfa.states[*partition.begin(block)].get();
+                auto state = std::make_unique<DFAState>(rep->is_accept);
+                state->rule = rep->rule;
+                block_state[block] = min_dfa->add_state(std::move(state));
+                pending.push(block);
+            }
+            return block_state[block];
+        };
+        const size_t start_block = partition.block_of(index.at(original_dfa.start));
+        if (start_block == dead_block) {
+            // 语言为空：只保留一个非接受的起始状态
+            min_dfa->start = min_dfa->add_state(std::make_unique<DFAState>(false));
+            return min_dfa;
+        }
+        min_dfa->start = state_of_block(start_block);
+        while (!pending.empty()) {
+            const size_t block = pending.front();
+            pending.pop();
+            DFAState *from = block_state[block];
+            const size_t rep = *partition.begin(block);
+            for (size_t b = 0; b < 256; ++b) {
+                const size_t target_block = partition.block_of(delta[rep * k + classes.map[b]]);
+                if (target_block == dead_block) continue;
+                from->transitions[static_cast<char>(b)] = state_of_block(target_block);
             }
         }
+        min_dfa->byte_classes = compute_byte_classes(*min_dfa);
         return min_dfa;
     }
 
@@ -516,9 +950,157 @@ namespace lexer::regex {
         return current->is_accept;
     }
 
+    // 最长匹配：记录沿途最后一次到达接受状态的位置
+    PrefixMatch longest_match(const DFA &dfa, const std::string_view input, const size_t pos) {
+        PrefixMatch result;
+        const auto *current = dfa.start;
+        if (!current) return result;
+        if (current->is_accept) result.rule = current->rule;
+        for (size_t i = pos; i < input.size(); ++i) {
+            auto it = current->transitions.find(input[i]);
+            if (it == current->transitions.end()) break;
+            current = it->second;
+            if (current->is_accept) {
+                result.length = i + 1 - pos;
+                result.rule = current->rule;
+            }
+        }
+        return result;
+    }
+
+    // 冻结：DFA -> 稠密转移表
+    DenseDFA freeze_dfa(const DFA &dfa) {
+        DenseDFA dense;
+        // 0 号为死状态，原 DFA 的第 i 个状态编号为 i + 1
+        dense.state_count = static_cast<uint32_t>(dfa.states.size() + 1);
+        dense.next.assign(dense.state_count * DenseDFA::ALPHABET_SIZE, DenseDFA::DEAD_STATE);
+        dense.accept.assign((dense.state_count + 63) / 64, 0);
+        dense.rules.assign(dense.state_count, -1);
+        std::unordered_map<const DFAState *, uint32_t> index;
+        for (size_t i = 0; i < dfa.states.size(); ++i) {
+            index[dfa.states[i].get()] = static_cast<uint32_t>(i + 1);
+        }
+        for (const auto &s: dfa.states) {
+            const uint32_t from = index.at(s.get());
+            if (s->is_accept) dense.accept[from >> 6] |= uint64_t{1} << (from & 63);
+            dense.rules[from] = s->rule;
+            for (const auto &[c, target]: s->transitions) {
+                dense.next[from * DenseDFA::ALPHABET_SIZE + static_cast<unsigned char>(c)] = index.at(target);
+            }
+        }
+        if (dfa.start) dense.start = index.at(dfa.start);
+        return dense;
+    }
+
+    // 匹配：稠密转移表版本，每个字节一次查表
+    bool match(const DenseDFA &dfa, const std::string_view input) {
+        uint32_t current = dfa.start;
+        for (const char c: input) {
+            if (current == DenseDFA::DEAD_STATE) return false;
+            current = dfa.step(current, c);
+        }
+        return current != DenseDFA::DEAD_STATE && dfa.is_accept(current);
+    }
+
+    // 最长匹配：稠密转移表版本
+    PrefixMatch longest_match(const DenseDFA &dfa, const std::string_view input, const size_t pos) {
+        PrefixMatch result;
+        uint32_t current = dfa.start;
+        if (current == DenseDFA::DEAD_STATE) return result;
+        if (dfa.is_accept(current)) result.rule = dfa.rules[current];
+        for (size_t i = pos; i < input.size(); ++i) {
+            current = dfa.step(current, input[i]);
+            if (current == DenseDFA::DEAD_STATE) break;
+            if (dfa.is_accept(current)) {
+                result.length = i + 1 - pos;
+                result.rule = dfa.rules[current];
+            }
+        }
+        return result;
+    }
+
+    // 字节等价类：每处理一个状态，就按 (原类别, 目标状态) 把已有的类再细分一次
+    ByteClasses compute_byte_classes(const DFA &dfa) {
+        std::array<int, 256> class_of{};
+        int class_count = 1;
+        for (const auto &s: dfa.states) {
+            if (s->transitions.empty()) continue;
+            std::array<const DFAState *, 256> target{};
+            for (const auto &[c, t]: s->transitions) target[static_cast<unsigned char>(c)] = t;
+            std::map<std::pair<int, const DFAState *>, int> refined;
+            for (size_t b = 0; b < 256; ++b) {
+                const auto key = std::make_pair(class_of[b], target[b]);
+                const auto [it, _] = refined.emplace(key, static_cast<int>(refined.size()));
+                class_of[b] = it->second;
+            }
+            class_count = static_cast<int>(refined.size());
+        }
+        ByteClasses classes;
+        for (size_t b = 0; b < 256; ++b) classes.map[b] = static_cast<uint8_t>(class_of[b]);
+        classes.count = static_cast<uint16_t>(class_count);
+        return classes;
+    }
+
+    // 压缩：DFA -> 按字节等价类压缩的转移表
+    // 字节类在此按 DFA 的实际转移重新计算，不信任 dfa.byte_classes：手工构建或修改过的 DFA 中该字段可能已过期
+    CompactDFA compress_dfa(const DFA &dfa) {
+        if (dfa.states.size() + 1 > CompactDFA::MAX_STATES) {
+            throw std::length_error("DFA has too many states for a compact table!");
+        }
+        CompactDFA compact;
+        compact.classes = compute_byte_classes(dfa);
+        const size_t class_count = compact.classes.count;
+        // 0 号为死状态，原 DFA 的第 i 个状态编号为 i + 1
+        compact.state_count = static_cast<uint32_t>(dfa.states.size() + 1);
+        compact.next.assign(compact.state_count * class_count, CompactDFA::DEAD_STATE);
+        compact.accept.assign((compact.state_count + 63) / 64, 0);
+        compact.rules.assign(compact.state_count, -1);
+        std::unordered_map<const DFAState *, uint16_t> index;
+        for (size_t i = 0; i < dfa.states.size(); ++i) {
+            index[dfa.states[i].get()] = static_cast<uint16_t>(i + 1);
+        }
+        for (const auto &s: dfa.states) {
+            const uint16_t from = index.at(s.get());
+            if (s->is_accept) compact.accept[from >> 6] |= uint64_t{1} << (from & 63);
+            compact.rules[from] = s->rule;
+            // 同一类中的字节转移目标相同，逐个写入结果一致
+            for (const auto &[c, target]: s->transitions) {
+                compact.next[from * class_count + compact.classes.of(c)] = index.at(target);
+            }
+        }
+        if (dfa.start) compact.start = index.at(dfa.start);
+        return compact;
+    }
+
+    // 匹配：压缩转移表版本
+    bool match(const CompactDFA &dfa, const std::string_view input) {
+        uint16_t current = dfa.start;
+        for (const char c: input) {
+            if (current == CompactDFA::DEAD_STATE) return false;
+            current = dfa.step(current, c);
+        }
+        return current != CompactDFA::DEAD_STATE && dfa.is_accept(current);
+    }
+
+    // 最长匹配：压缩转移表版本
+    PrefixMatch longest_match(const CompactDFA &dfa, const std::string_view input, const size_t pos) {
+        PrefixMatch result;
+        uint16_t current = dfa.start;
+        if (current == CompactDFA::DEAD_STATE) return result;
+        if (dfa.is_accept(current)) result.rule = dfa.rules[current];
+        for (size_t i = pos; i < input.size(); ++i) {
+            current = dfa.step(current, input[i]);
+            if (current == CompactDFA::DEAD_STATE) break;
+            if (dfa.is_accept(current)) {
+                result.length = i + 1 - pos;
+                result.rule = dfa.rules[current];
+            }
+        }
+        return result;
+    }
+
     // 工具函数：重置状态 ID 计数器，用于多次测试/构建
     void reset_state_counters() {
-        nfa_state_id_counter = 0;
         dfa_state_id_counter = 0;
     }
 }
@@ -0,0 +1,104 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <stdexcept>
+#include <lexer/regex/lazy.hpp>
+
+namespace lexer::regex {
+    // 构造函数：只做 ε 闭包与字节类的预处理，不进行子集构造
+    LazyDFA::LazyDFA(std::unique_ptr<NFA> nfa, const size_t memory_budget)
+        : nfa(std::move(nfa)), memory_budget(memory_budget) {
+        if (!this->nfa || this->nfa->start == NFAState::NONE) {
+            throw std::invalid_argument("Cannot build lazy DFA from invalid NFA!");
+        }
+        this->closures = epsilon_closures(*this->nfa);
+        this->classes = compute_byte_classes(*this->nfa);
+        this->start_set = StateSet(this->nfa->states.size());
+        for (const uint32_t i: this->closures[this->nfa->start]) this->start_set.insert(i);
+        reset_cache();
+    }
+
+    // 清空缓存，只保留死状态与起始状态
+    void LazyDFA::reset_cache() {
+        this->states.clear();
+        this->next.clear();
+        this->state_map.clear();
+        this->memory_usage = 0;
+        find_or_add(StateSet(this->nfa->states.size()));
+        this->start = find_or_add(StateSet(this->start_set));
+    }
+
+    // 查找或构造状态集合对应的缓存状态
+    uint32_t LazyDFA::find_or_add(StateSet &&set) {
+        const auto it = this->state_map.find(set);
+        if (it != this->state_map.end()) return it->second;
+        // 接受性与规则编号：规则取编号最小（优先级最高）者
+        bool is_accept = false;
+        int rule = -1;
+        set.for_each([&](const size_t i) {
+            const auto &s = this->nfa->states[i];
+            if (!s.is_accept) return;
+            is_accept = true;
+            if (s.rule >= 0 && (rule < 0 || s.rule < rule)) rule = s.rule;
+        });
+        const auto id = static_cast<uint32_t>(this->states.size());
+        // 估算内存：位集 + 转移行 + 哈希表中的一份位集与节点开销
+        this->memory_usage += 2 * set.words.size() * sizeof(uint64_t) +
+                this->classes.count * sizeof(uint32_t) + sizeof(CachedState) + 64;
+        this->state_map.emplace(set, id);
+        this->states.push_back({std::move(set), is_accept, rule});
+        // 死状态的所有转移都指向自身，其余状态的转移待计算
+        this->next.resize(this->next.size() + this->classes.count, id == DEAD_STATE ? DEAD_STATE : UNKNOWN);
+        return id;
+    }
+
+    // 计算转移：取该字节类中任意一个字节作为代表，沿带标签的边前进后求 ε 闭包
+    uint32_t LazyDFA::compute_transition(const uint32_t state, const uint8_t cls) {
+        size_t representative = 0;
+        while (this->classes.map[representative] != cls) ++representative;
+        StateSet target_set(this->nfa->states.size());
+        this->states[state].set.for_each([&](const size_t i) {
+            const auto &s = this->nfa->states[i];
+            if (!s.has_label() || !s.label.test(representative)) return;
+            for (const uint32_t j: this->closures[s.out]) target_set.insert(j);
+        });
+        uint32_t from = state;
+        // 超出预算：清空缓存后重新加入当前状态，保证匹配可以继续
+        if (this->memory_usage > this->memory_budget) {
+            StateSet current = this->states[state].set;
+            reset_cache();
+            ++this->flushes;
+            from = find_or_add(std::move(current));
+        }
+        const uint32_t target = find_or_add(std::move(target_set));
+        this->next[static_cast<size_t>(from) * this->classes.count + cls] = target;
+        return target;
+    }
+
+    // 匹配：输入字符串 -> 是否完全匹配
+    bool LazyDFA::match(const std::string_view input) {
+        uint32_t current = this->start;
+        for (const char c: input) {
+            current = step(current, c);
+            if (current == DEAD_STATE) return false;
+        }
+        return this->states[current].is_accept;
+    }
+
+    // 最长匹配：记录沿途最后一次到达接受状态的位置
+    PrefixMatch LazyDFA::longest_match(const std::string_view input, const size_t pos) {
+        PrefixMatch result;
+        uint32_t current = this->start;
+        if (this->states[current].is_accept) result.rule = this->states[current].rule;
+        for (size_t i = pos; i < input.size(); ++i) {
+            current = step(current, input[i]);
+            if (current == DEAD_STATE) break;
+            if (this->states[current].is_accept) {
+                result.length = i + 1 - pos;
+                result.rule = this->states[current].rule;
+            }
+        }
+        return result;
+    }
+}
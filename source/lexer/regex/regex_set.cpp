@@ -0,0 +1,75 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <lexer/regex/regex_set.hpp>
+
+namespace lexer::regex {
+    // 构造：各模式的 NFA 合并为带规则编号的 NFA，子集构造时同时收集每个 DFA 状态接受的全部模式
+    RegexSet::RegexSet(const std::vector<std::string> &patterns) : pattern_count(patterns.size()) {
+        if (patterns.empty()) {
+            throw std::invalid_argument("Cannot build a regex set from an empty pattern list!");
+        }
+        std::vector<std::unique_ptr<NFA> > rules;
+        rules.reserve(patterns.size());
+        for (const std::string &pattern: patterns) rules.push_back(regex_to_nfa(pattern));
+        std::vector<StateSet> rule_sets;
+        const auto dfa = build_dfa(combine_rules(std::move(rules)), &rule_sets);
+
+        // 1. 状态编号：0 为死状态，dfa->states[i] 编号为 i + 1
+        this->classes = dfa->byte_classes;
+        this->words = (this->pattern_count + 63) / 64;
+        const size_t state_count = dfa->states.size() + 1;
+        std::unordered_map<const DFAState *, uint32_t> index;
+        for (size_t i = 0; i < dfa->states.size(); ++i) index[dfa->states[i].get()] = static_cast<uint32_t>(i + 1);
+        this->start = index.at(dfa->start);
+
+        // 2. 每个字节类取一个代表字节，按类填充转移表，缺失的转移指向死状态
+        std::vector<unsigned char> representative(this->classes.count);
+        for (size_t b = 256; b-- > 0;) representative[this->classes.map[b]] = static_cast<unsigned char>(b);
+        this->next.assign(state_count * this->classes.count, DEAD_STATE);
+        this->match_sets.assign(state_count * this->words, 0);
+        for (size_t i = 0; i < dfa->states.size(); ++i) {
+            const auto &transitions = dfa->states[i]->transitions;
+            uint32_t *row = this->next.data() + (i + 1) * this->classes.count;
+            for (uint16_t cls = 0; cls < this->classes.count; ++cls) {
+                const auto it = transitions.find(static_cast<char>(representative[cls]));
+                if (it != transitions.end()) row[cls] = index.at(it->second);
+            }
+            // 3. 模式位集：rule_sets 的宽度为最大模式编号 + 1，不超过 words
+            const std::vector<uint64_t> &rule_words = rule_sets[i].words;
+            std::copy(rule_words.begin(), rule_words.end(), this->match_sets.begin() + (i + 1) * this->words);
+        }
+    }
+
+    uint32_t RegexSet::run(const std::string_view input) const {
+        uint32_t state = this->start;
+        for (const char c: input) {
+            state = this->next[static_cast<size_t>(state) * this->classes.count + this->classes.of(c)];
+            if (state == DEAD_STATE) break;
+        }
+        return state;
+    }
+
+    std::vector<size_t> RegexSet::matches(const std::string_view input) const {
+        std::vector<size_t> ids;
+        const uint64_t *set = match_set(run(input));
+        for (size_t i = 0; i < this->words; ++i) {
+            for (uint64_t w = set[i]; w; w &= w - 1) {
+                ids.push_back(i * 64 + static_cast<size_t>(__builtin_ctzll(w)));
+            }
+        }
+        return ids;
+    }
+
+    bool RegexSet::is_match(const std::string_view input) const {
+        const uint64_t *set = match_set(run(input));
+        for (size_t i = 0; i < this->words; ++i) {
+            if (set[i]) return true;
+        }
+        return false;
+    }
+}
@@ -0,0 +1,57 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <lexer/regex/rule_lexer.hpp>
+
+// 辅助函数
+namespace lexer::regex {
+    namespace {
+        // 从 state 出发继续读取的最多字节数：读到死状态或接受状态为止（该字节计入），非接受状态之间有环时为 UNBOUNDED
+        // reads 为各状态的记忆结果，0 表示尚未计算，visiting 标记递归栈上的状态用于发现环
+        size_t reads_from(const CompactDFA &dfa, const uint16_t state, std::vector<size_t> &reads,
+                          std::vector<bool> &visiting) {
+            if (reads[state] != 0) return reads[state];
+            if (visiting[state]) return RuleLexer::UNBOUNDED;
+            visiting[state] = true;
+            size_t longest = 1;
+            for (size_t c = 0; c < dfa.classes.count && longest != RuleLexer::UNBOUNDED; ++c) {
+                const uint16_t next = dfa.next[static_cast<size_t>(state) * dfa.classes.count + c];
+                if (next == CompactDFA::DEAD_STATE || dfa.is_accept(next)) continue;
+                const size_t further = reads_from(dfa, next, reads, visiting);
+                longest = further == RuleLexer::UNBOUNDED ? further : std::max(longest, further + 1);
+            }
+            visiting[state] = false;
+            return reads[state] = longest;
+        }
+    }
+}
+
+namespace lexer::regex {
+    // 构造：第 i 条规则的 NFA 标记为规则 i，合并后经子集构造、最小化与字节类压缩得到转移表
+    RuleLexer::RuleLexer(std::vector<LexRule> rules) : rule_table(std::move(rules)) {
+        std::vector<std::unique_ptr<NFA> > nfas;
+        nfas.reserve(this->rule_table.size());
+        for (const LexRule &rule: this->rule_table) nfas.push_back(regex_to_nfa(rule.regex));
+        const auto dfa = build_dfa(combine_rules(std::move(nfas)));
+        this->token_dfa = compress_dfa(*minimize_dfa(*dfa));
+
+        // 越过 Token 末尾的读取都从某个接受状态开始，没有匹配时从起始状态开始
+        std::vector<size_t> reads(this->token_dfa.state_count, 0);
+        std::vector<bool> visiting(this->token_dfa.state_count, false);
+        for (uint32_t state = 1; state < this->token_dfa.state_count; ++state) {
+            if (state != this->token_dfa.start && !this->token_dfa.is_accept(static_cast<uint16_t>(state))) continue;
+            this->lookahead = std::max(this->lookahead,
+                                       reads_from(this->token_dfa, static_cast<uint16_t>(state), reads, visiting));
+        }
+    }
+
+    // 最长匹配后按规则下标查出 Token 种类
+    LexMatch RuleLexer::next_token(const std::string_view buffer, const size_t pos) const {
+        const PrefixMatch match = longest_match(this->token_dfa, buffer, pos);
+        if (match.length == 0) return {};
+        return {match.length, match.rule, this->rule_table[static_cast<size_t>(match.rule)].kind};
+    }
+}
@@ -0,0 +1,79 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include "skip_kernels.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// SSE2 指令集特征：每次处理 16 字节
+#if defined(__SSE2__)
+namespace lexer::simd {
+    namespace {
+        struct Sse2 {
+            using Vector = __m128i;
+            static constexpr size_t WIDTH = 16;
+            static constexpr uint32_t FULL_MASK = 0xffff;
+
+            static Vector load(const char *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+            static Vector splat(const char c) { return _mm_set1_epi8(c); }
+            static Vector eq(const Vector a, const Vector b) { return _mm_cmpeq_epi8(a, b); }
+            static Vector either(const Vector a, const Vector b) { return _mm_or_si128(a, b); }
+            static Vector both(const Vector a, const Vector b) { return _mm_and_si128(a, b); }
+            static uint32_t mask(const Vector v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+
+            // 有符号比较：low <= x <= high
+            static Vector in_range(const Vector x, const char low, const char high) {
+                return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(static_cast<char>(low - 1))),
+                                     _mm_cmplt_epi8(x, _mm_set1_epi8(static_cast<char>(high + 1))));
+            }
+        };
+    }
+}
+#endif
+
+// 运行时分派
+namespace lexer::simd {
+    namespace {
+        constexpr SkipKernels scalar_kernels = {
+            Isa::SCALAR, &scalar::skip_whitespace, &scalar::skip_identifier, &scalar::find_byte,
+            &scalar::find_comment_end, &scalar::find_quote_end
+        };
+#if defined(__SSE2__)
+        constexpr SkipKernels sse2_kernels = VectorKernels<Sse2>::table(Isa::SSE2);
+#endif
+    }
+
+    // 当前 CPU 支持的最高指令集：AVX2 需要编译器支持且运行时检测通过，SSE2 为 x86-64 的基线
+    Isa detect_isa() {
+#if defined(POCOM_HAVE_AVX2)
+        if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+#endif
+#if defined(__SSE2__)
+        return Isa::SSE2;
+#else
+        return Isa::SCALAR;
+#endif
+    }
+
+    // 指定指令集的内核表，不可用时逐级回退
+    const SkipKernels &kernels_for(const Isa isa) {
+        const Isa available = detect_isa();
+        const Isa chosen = static_cast<int>(isa) <= static_cast<int>(available) ? isa : available;
+#if defined(POCOM_HAVE_AVX2)
+        if (chosen == Isa::AVX2) return avx2_kernels();
+#endif
+#if defined(__SSE2__)
+        if (chosen == Isa::SSE2) return sse2_kernels;
+#endif
+        return scalar_kernels;
+    }
+
+    // 当前 CPU 的内核表：局部静态变量保证只检测一次
+    const SkipKernels &kernels() {
+        static const SkipKernels &active = kernels_for(detect_isa());
+        return active;
+    }
+}
@@ -0,0 +1,40 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+// 本文件以 -mavx2 编译（见 CMakeLists.txt），只有在运行时检测到 AVX2 后才会调用其中的内核
+#include "skip_kernels.hpp"
+
+#if defined(POCOM_HAVE_AVX2)
+#include <immintrin.h>
+
+// AVX2 指令集特征：每次处理 32 字节
+namespace lexer::simd {
+    namespace {
+        struct Avx2 {
+            using Vector = __m256i;
+            static constexpr size_t WIDTH = 32;
+            static constexpr uint32_t FULL_MASK = 0xffffffff;
+
+            static Vector load(const char *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+            static Vector splat(const char c) { return _mm256_set1_epi8(c); }
+            static Vector eq(const Vector a, const Vector b) { return _mm256_cmpeq_epi8(a, b); }
+            static Vector either(const Vector a, const Vector b) { return _mm256_or_si256(a, b); }
+            static Vector both(const Vector a, const Vector b) { return _mm256_and_si256(a, b); }
+            static uint32_t mask(const Vector v) { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); }
+
+            // 有符号比较：low <= x <= high
+            static Vector in_range(const Vector x, const char low, const char high) {
+                return _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8(static_cast<char>(low - 1))),
+                                        _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(high + 1)), x));
+            }
+        };
+
+        constexpr SkipKernels avx2_table = VectorKernels<Avx2>::table(Isa::AVX2);
+    }
+
+    const SkipKernels &avx2_kernels() {
+        return avx2_table;
+    }
+}
+#endif
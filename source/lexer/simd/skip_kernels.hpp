@@ -0,0 +1,142 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#ifndef POCOM_SKIP_KERNELS_HPP
+#define POCOM_SKIP_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <lexer/simd/skip.hpp>
+
+// 仅供 skip.cpp/skip_avx2.cpp 使用的内核实现：标量版本处理尾部，向量版本由指令集特征类实例化
+// 两个翻译单元的编译选项不同（skip_avx2.cpp 带 -mavx2），所有定义放在匿名命名空间中，
+// 避免链接器把带 AVX2 指令的内联函数副本合并给基线代码使用
+
+// 1. 标量内核
+namespace lexer::simd::scalar {
+    namespace {
+        inline bool is_whitespace(const char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+        }
+
+        inline bool is_identifier(const char c) {
+            const char lower = static_cast<char>(c | 0x20);
+            return (lower >= 'a' && lower <= 'z') || (c >= '0' && c <= '9') || c == '_';
+        }
+
+        inline size_t skip_whitespace(const char *data, const size_t size, size_t pos) {
+            while (pos < size && is_whitespace(data[pos])) ++pos;
+            return pos;
+        }
+
+        inline size_t skip_identifier(const char *data, const size_t size, size_t pos) {
+            while (pos < size && is_identifier(data[pos])) ++pos;
+            return pos;
+        }
+
+        inline size_t find_byte(const char *data, const size_t size, size_t pos, const char target) {
+            while (pos < size && data[pos] != target) ++pos;
+            return pos;
+        }
+
+        inline size_t find_comment_end(const char *data, const size_t size, size_t pos) {
+            while (pos + 1 < size && !(data[pos] == '*' && data[pos + 1] == '/')) ++pos;
+            return pos + 1 < size ? pos : size;
+        }
+
+        // 反斜杠连同其后的一个字节一起跳过，连续反斜杠因此按奇偶配对
+        inline size_t find_quote_end(const char *data, const size_t size, size_t pos, const char quote) {
+            while (pos < size && data[pos] != quote) pos += data[pos] == '\\' ? 2 : 1;
+            return pos < size ? pos : size;
+        }
+    }
+}
+
+// 2. 向量内核：V 提供 WIDTH、FULL_MASK、load、splat、eq、in_range、either、both、mask，mask 的第 i 位对应第 i 个字节
+namespace lexer::simd {
+    namespace {
+        template<typename V>
+        struct VectorKernels {
+            // 最低置位的下标
+            static size_t first_set(const uint32_t mask) { return static_cast<size_t>(__builtin_ctz(mask)); }
+
+            static size_t skip_whitespace(const char *data, const size_t size, size_t pos) {
+                const auto space = V::splat(' '), tab = V::splat('\t'), newline = V::splat('\n');
+                const auto carriage = V::splat('\r'), feed = V::splat('\f');
+                for (; pos + V::WIDTH <= size; pos += V::WIDTH) {
+                    const auto x = V::load(data + pos);
+                    const auto hit = V::either(V::either(V::eq(x, space), V::eq(x, tab)),
+                                               V::either(V::either(V::eq(x, newline), V::eq(x, carriage)),
+                                                         V::eq(x, feed)));
+                    const uint32_t miss = ~V::mask(hit) & V::FULL_MASK;
+                    if (miss) return pos + first_set(miss);
+                }
+                return scalar::skip_whitespace(data, size, pos);
+            }
+
+            static size_t skip_identifier(const char *data, const size_t size, size_t pos) {
+                const auto case_bit = V::splat(0x20), underscore = V::splat('_');
+                for (; pos + V::WIDTH <= size; pos += V::WIDTH) {
+                    const auto x = V::load(data + pos);
+                    // 字母统一转为小写后判断范围，高位字节按有符号比较为负数，不会落入任何范围
+                    const auto hit = V::either(V::either(V::in_range(V::either(x, case_bit), 'a', 'z'),
+                                                         V::in_range(x, '0', '9')),
+                                               V::eq(x, underscore));
+                    const uint32_t miss = ~V::mask(hit) & V::FULL_MASK;
+                    if (miss) return pos + first_set(miss);
+                }
+                return scalar::skip_identifier(data, size, pos);
+            }
+
+            static size_t find_byte(const char *data, const size_t size, size_t pos, const char target) {
+                const auto needle = V::splat(target);
+                for (; pos + V::WIDTH <= size; pos += V::WIDTH) {
+                    const uint32_t hit = V::mask(V::eq(V::load(data + pos), needle));
+                    if (hit) return pos + first_set(hit);
+                }
+                return scalar::find_byte(data, size, pos, target);
+            }
+
+            static size_t find_comment_end(const char *data, const size_t size, size_t pos) {
+                const auto star = V::splat('*'), slash = V::splat('/');
+                // 同时加载 pos 与 pos + 1 开始的两段，'*' 后紧跟 '/' 的位置两段的比较结果同时为真
+                for (; pos + V::WIDTH + 1 <= size; pos += V::WIDTH) {
+                    const auto hit = V::both(V::eq(V::load(data + pos), star),
+                                             V::eq(V::load(data + pos + 1), slash));
+                    const uint32_t mask = V::mask(hit);
+                    if (mask) return pos + first_set(mask);
+                }
+                return scalar::find_comment_end(data, size, pos);
+            }
+
+            static size_t find_quote_end(const char *data, const size_t size, size_t pos, const char quote) {
+                const auto needle = V::splat(quote), backslash = V::splat('\\');
+                // 同时查找引号与反斜杠：遇到引号即返回，遇到反斜杠跳过它和被转义的字节后从该处重新加载
+                while (pos + V::WIDTH <= size) {
+                    const auto x = V::load(data + pos);
+                    const uint32_t hit = V::mask(V::either(V::eq(x, needle), V::eq(x, backslash)));
+                    if (!hit) {
+                        pos += V::WIDTH;
+                        continue;
+                    }
+                    pos += first_set(hit);
+                    if (data[pos] == quote) return pos;
+                    pos += 2;
+                }
+                return scalar::find_quote_end(data, size, pos, quote);
+            }
+
+            static constexpr SkipKernels table(const Isa isa) {
+                return {isa, &skip_whitespace, &skip_identifier, &find_byte, &find_comment_end, &find_quote_end};
+            }
+        };
+    }
+
+#ifdef POCOM_HAVE_AVX2
+    // AVX2 内核表，定义在以 -mavx2 编译的 skip_avx2.cpp 中，仅在运行时检测到 AVX2 后使用
+    const SkipKernels &avx2_kernels();
+#endif
+}
+
+#endif //POCOM_SKIP_KERNELS_HPP
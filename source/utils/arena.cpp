@@ -0,0 +1,45 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <utils/arena.hpp>
+
+namespace utils {
+    Arena::Arena(const size_t first_block) : next_block(std::max<size_t>(first_block, 64)) {}
+
+    // 当前块不足时申请新块：超过块大小的请求单独占一块，块内存不初始化
+    char *Arena::allocate(const size_t size) {
+        if (size > this->remaining) {
+            const size_t block = std::max(size, this->next_block);
+            this->blocks.push_back(std::unique_ptr<char[]>(new char[block]));
+            this->cursor = this->blocks.back().get();
+            this->remaining = block;
+            this->next_block = std::min(this->next_block * 2, MAX_BLOCK);
+        }
+        char *result = this->cursor;
+        this->cursor += size;
+        this->remaining -= size;
+        this->used_bytes += size;
+        return result;
+    }
+
+    std::string_view Arena::store(const std::string_view text) {
+        return concat({text});
+    }
+
+    // 先计算总长度，一次分配后依次复制
+    std::string_view Arena::concat(const std::initializer_list<std::string_view> parts) {
+        size_t length = 0;
+        for (const std::string_view part: parts) length += part.size();
+        char *data = allocate(length);
+        char *out = data;
+        for (const std::string_view part: parts) {
+            if (part.empty()) continue;
+            std::memcpy(out, part.data(), part.size());
+            out += part.size();
+        }
+        return {data, length};
+    }
+}
@@ -0,0 +1,99 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <algorithm>
+#include <utils/thread_pool.hpp>
+
+// 当前线程所属的线程池与队列下标，工作线程内部提交的任务直接放入自己的队列
+namespace utils {
+    namespace {
+        thread_local const ThreadPool *current_pool = nullptr;
+        thread_local size_t current_index = 0;
+    }
+}
+
+namespace utils {
+    // 为每个工作线程创建队列后启动线程
+    ThreadPool::ThreadPool(size_t threads) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        this->queues.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            this->queues.push_back(std::make_unique<Queue>());
+        }
+        this->workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            this->workers.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    // 通知所有线程退出，等待所有任务执行完毕
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(this->sleep_mutex);
+            this->stopping = true;
+        }
+        this->ready.notify_all();
+        for (std::thread &worker: this->workers) {
+            worker.join();
+        }
+    }
+
+    // 任务入队：先放入队列再增加计数，计数大于 0 时队列中一定能取到任务
+    void ThreadPool::enqueue(std::function<void()> job) {
+        const size_t index = current_pool == this
+                                 ? current_index
+                                 : this->next_queue.fetch_add(1, std::memory_order_relaxed) % this->queues.size();
+        {
+            Queue &queue = *this->queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+        this->pending.fetch_add(1);
+        // 持有休眠锁再通知，避免与检查条件后正要休眠的线程错过唤醒
+        {
+            std::lock_guard<std::mutex> lock(this->sleep_mutex);
+        }
+        this->ready.notify_one();
+    }
+
+    // 取任务：自己的队列后进先出，窃取时先进先出，窃取到的通常是较早提交、尚未开始的任务
+    bool ThreadPool::take(const size_t index, std::function<void()> &job) {
+        {
+            Queue &own = *this->queues[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < this->queues.size(); ++offset) {
+            Queue &victim = *this->queues[(index + offset) % this->queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 工作线程：有任务时持续执行，没有任务时休眠，停止且所有任务都已取走时退出
+    void ThreadPool::worker_loop(const size_t index) {
+        current_pool = this;
+        current_index = index;
+        while (true) {
+            std::function<void()> job;
+            if (take(index, job)) {
+                this->pending.fetch_sub(1);
+                job();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(this->sleep_mutex);
+            if (this->stopping && this->pending.load() == 0) return;
+            this->ready.wait(lock, [this] { return this->stopping || this->pending.load() > 0; });
+        }
+    }
+}
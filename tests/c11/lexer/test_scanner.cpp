@@ -3,11 +3,16 @@
 //
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <string>
+#include <unistd.h>
+#include <c11/lexer/keywords.hpp>
+#include <c11/lexer/punctuation.hpp>
 #include <c11/lexer/scanner.hpp>
+#include <utils/thread_pool.hpp>
 using namespace c11;
 
 
@@ -210,6 +215,33 @@ TEST(ScannerTest, IllegalEscapeError) {
     EXPECT_EQ(errors[1].type, ErrorType::ILLEGAL_ESCAPE);
 }
 
+// 测试以转义反斜杠结尾的字符串与字符常量：\\ 之后的引号是闭合引号，后续 Token 照常扫描
+TEST(ScannerTest, EscapedBackslashBeforeQuote) {
+    const std::string code = "\"a\\\\\" x; '\\\\' \"b\\\\\\\"c\" y";
+    const std::string expected = "[STRING:\"a\\\\\"] [IDENTIFIER:x] [PUNCTUATOR:;] [CHAR:'\\\\'] "
+            "[STRING:\"b\\\\\\\"c\"] [IDENTIFIER:y] ";
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const auto [tokens, errors] = scanner.scan(code);
+        EXPECT_TRUE(errors.empty());
+        EXPECT_EQ(tokens_to_string(tokens), expected);
+    }
+}
+
+// 测试从临时扫描结果中拷贝出的错误：错误共享持有描述所在的 arena，结果销毁后 message 仍然有效
+TEST(ScannerTest, ErrorOutlivesResult) {
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const auto error = scanner.scan("int x = @;").errors[0];
+        // 再扫描一次，复用可能被释放的内存
+        const auto other = scanner.scan(std::string(4096, '$'));
+        EXPECT_EQ(other.errors.size(), 4096);
+        EXPECT_EQ(error.type, ErrorType::INVALID_CHARACTER);
+        EXPECT_EQ(error.message, "Invalid character ('@')");
+        EXPECT_EQ(error.offset, 8);
+    }
+}
+
 // 测试未闭合多行注释错误
 TEST(ScannerTest, IncompleteCommentError) {
     const Scanner scanner;
@@ -272,6 +304,269 @@ TEST(ScannerTest, ComplexCodeFragment) {
     EXPECT_TRUE(found_fibonacci);
 }
 
+// 测试 DFA 模式下的非法八进制整数检测
+TEST(ScannerTest, DfaModeInvalidOctal) {
+    const Scanner scanner(ScanMode::DFA);
+    const std::string code = "0123 089 0x1F";
+
+    const auto [tokens, errors] = scanner.scan(code);
+
+    EXPECT_EQ(tokens.size(), 3);
+    EXPECT_EQ(errors.size(), 1);
+    EXPECT_EQ(errors[0].type, ErrorType::INVALID_INTEGER);
+    EXPECT_EQ(errors[0].column, 6);
+}
+
+// 测试 DFA 模式与 REGEX 模式在普通代码上的结果一致
+TEST(ScannerTest, DfaModeMatchesRegexMode) {
+    const Scanner dfa_scanner(ScanMode::DFA);
+    const Scanner regex_scanner(ScanMode::REGEX);
+    const std::string code = "int main(void) {\n"
+            "    char *s = \"a\\tb\"; // 注释\n"
+            "    double d = 1.5e3 + .25;\n"
+            "    return s[0] != 'a' && d >= 0x1F;\n"
+            "}";
+
+    const auto dfa_result = dfa_scanner.scan(code);
+    const auto regex_result = regex_scanner.scan(code);
+
+    EXPECT_EQ(dfa_scanner.scan_mode(), ScanMode::DFA);
+    EXPECT_EQ(regex_scanner.scan_mode(), ScanMode::REGEX);
+    EXPECT_EQ(tokens_to_string(dfa_result.tokens), tokens_to_string(regex_result.tokens));
+    EXPECT_EQ(errors_to_string(dfa_result.errors), errors_to_string(regex_result.errors));
+}
+
+// 测试数字常量在两种模式下的 Token 与错误完全相同：后缀、非法八进制、不完整的指数与十六进制
+TEST(ScannerTest, NumericLiteralsMatchAcrossModes) {
+    const std::string code = "0 7 42u 42U 42l 42L 42ll 42LL 42ul 42lu 42ULL 42llu 42Ul 0x1F 0X1fUL 0xffLLu\n"
+            "0123 089 0789u 08 09L 00 0x 0xg 1.5 1. .5 1.5e3 1e5 1E+5 1.5e-3f 1.5F 2.L .5l 1e 1e+ 1.5e+x\n"
+            "089.5 09e1 0x1.5 1..2 1.5.6 42uu 42lul 1f 1.5fl 0x1e5 0x1E+5 12abc 3.14_x ...\n";
+    const auto dfa_result = Scanner(ScanMode::DFA).scan(code);
+    const auto regex_result = Scanner(ScanMode::REGEX).scan(code);
+    EXPECT_EQ(tokens_to_string(dfa_result.tokens), tokens_to_string(regex_result.tokens));
+    EXPECT_EQ(errors_to_string(dfa_result.errors), errors_to_string(regex_result.errors));
+    // 089、0789u、08、09L 四个非法八进制
+    EXPECT_EQ(regex_result.errors.size(), 4);
+    for (const ScanError &error: regex_result.errors) EXPECT_EQ(error.type, ErrorType::INVALID_INTEGER);
+}
+
+// 测试 Token 直接引用 ScanResult 持有的源缓冲区，结果移动后仍然有效
+TEST(ScannerTest, TokensViewSourceBuffer) {
+    const Scanner scanner;
+    std::string code = "int x = 42; // done";
+    ScanResult moved;
+    {
+        ScanResult result = scanner.scan(code);
+        code.assign(code.size(), '?');
+        moved = std::move(result);
+    }
+    ASSERT_EQ(moved.tokens.size(), 6);
+    const std::string_view source = moved.source->view();
+    for (const auto &token: moved.tokens) {
+        EXPECT_GE(token.value.data(), source.data());
+        EXPECT_LE(token.value.data() + token.value.size(), source.data() + source.size());
+    }
+    EXPECT_EQ(moved.tokens[1].value, "x");
+    EXPECT_EQ(moved.tokens[5].value, "// done");
+}
+
+// 测试文件扫描：普通文件 mmap 映射，管道回退为读入内存，结果与字符串扫描一致
+TEST(ScannerTest, ScanFileMappedAndFallback) {
+    const Scanner scanner;
+    const std::string code = "int main(void) { return 0x1F; }\n";
+    const std::string path = testing::TempDir() + "pocom_scan_file.c";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << code;
+    }
+    const auto expected = scanner.scan(code);
+    const auto mapped = scanner.scan_file(path);
+    EXPECT_TRUE(mapped.source->is_mapped());
+    EXPECT_EQ(tokens_to_string(mapped.tokens), tokens_to_string(expected.tokens));
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], code.data(), code.size()), static_cast<ssize_t>(code.size()));
+    close(fds[1]);
+    const auto piped = scanner.scan_file("/dev/fd/" + std::to_string(fds[0]));
+    close(fds[0]);
+    EXPECT_FALSE(piped.source->is_mapped());
+    EXPECT_EQ(tokens_to_string(piped.tokens), tokens_to_string(expected.tokens));
+
+    std::remove(path.c_str());
+    EXPECT_THROW((void) scanner.scan_file(path), std::runtime_error);
+}
+
+// 测试批量扫描：结果与输入路径一一对应，读取失败的文件单独记录
+TEST(ScannerTest, ScanFilesBatch) {
+    const Scanner scanner;
+    const std::vector<std::string> sources{"int a;", std::string(5000, ' ') + "x = 1 + 2;", "@"};
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        paths.push_back(testing::TempDir() + "pocom_batch_" + std::to_string(i) + ".c");
+        std::ofstream file(paths.back(), std::ios::binary);
+        file << sources[i];
+    }
+    paths.push_back(testing::TempDir() + "pocom_batch_missing.c");
+
+    utils::ThreadPool pool(2);
+    const std::vector<FileScanResult> results = scanner.scan_files(paths, pool);
+    ASSERT_EQ(results.size(), paths.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        EXPECT_EQ(results[i].path, paths[i]);
+        EXPECT_TRUE(results[i].failure.empty());
+        const auto expected = scanner.scan(sources[i]);
+        EXPECT_EQ(tokens_to_string(results[i].result.tokens), tokens_to_string(expected.tokens));
+        EXPECT_EQ(errors_to_string(results[i].result.errors), errors_to_string(expected.errors));
+        std::remove(paths[i].c_str());
+    }
+    EXPECT_EQ(results[3].path, paths[3]);
+    EXPECT_FALSE(results[3].failure.empty());
+    EXPECT_TRUE(results[3].result.tokens.empty());
+}
+
+// 测试完美哈希关键字表：所有 C11 关键字都能识别，相近的标识符不会误判
+TEST(ScannerTest, KeywordPerfectHash) {
+    for (const auto keyword: KEYWORDS) {
+        EXPECT_TRUE(is_c11_keyword(keyword)) << keyword;
+    }
+    for (const std::string_view word: {"a", "Int", "inlined", "_Boo", "whilee", "_Static_asser", "restrictx", "x"}) {
+        EXPECT_FALSE(is_c11_keyword(word)) << word;
+    }
+    static_assert(is_c11_keyword("_Thread_local") && !is_c11_keyword("thread_local"));
+
+    const Scanner scanner;
+    const auto [tokens, errors] = scanner.scan("static inline _Bool f(int *restrict p);");
+    EXPECT_TRUE(errors.empty());
+    EXPECT_EQ(tokens_to_string(tokens),
+              "[KEYWORD:static] [KEYWORD:inline] [KEYWORD:_Bool] [IDENTIFIER:f] [PUNCTUATOR:(] [KEYWORD:int] "
+              "[OPERATOR:*] [KEYWORD:restrict] [IDENTIFIER:p] [PUNCTUATOR:)] [PUNCTUATOR:;] ");
+}
+
+// 测试运算符与标点的最长匹配：两种模式都不会把 <<=、>>=、## 拆开
+TEST(ScannerTest, PunctuationLongestMatch) {
+    const std::string code = "a<<=b>>=c##d->e:f";
+    const std::string expected = "[IDENTIFIER:a] [OPERATOR:<<=] [IDENTIFIER:b] [OPERATOR:>>=] [IDENTIFIER:c] "
+            "[PUNCTUATOR:##] [IDENTIFIER:d] [OPERATOR:->] [IDENTIFIER:e] [OPERATOR::] [IDENTIFIER:f] ";
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const auto [tokens, errors] = scanner.scan(code);
+        EXPECT_TRUE(errors.empty());
+        EXPECT_EQ(tokens_to_string(tokens), expected);
+    }
+    EXPECT_EQ(longest_punctuation("<<=", 0, KIND_OPERATOR), 3);
+    EXPECT_EQ(longest_punctuation("<<=", 0, KIND_PUNCTUATOR), 0);
+    EXPECT_EQ(longest_punctuation("x##", 1, KIND_PUNCTUATOR), 2);
+    EXPECT_EQ(longest_punctuation("->", 0, KIND_PUNCTUATOR), 0);
+}
+
+// 测试省略号：两种模式都产生单个 ... 标点，而不是三个 . 运算符
+TEST(ScannerTest, EllipsisPunctuator) {
+    const std::string expected = "[KEYWORD:int] [IDENTIFIER:f] [PUNCTUATOR:(] [KEYWORD:int] [IDENTIFIER:a] "
+            "[PUNCTUATOR:,] [PUNCTUATOR:...] [PUNCTUATOR:)] [IDENTIFIER:s] [OPERATOR:.] [IDENTIFIER:x] "
+            "[OPERATOR:.] [OPERATOR:.] [PUNCTUATOR:;] ";
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const auto [tokens, errors] = scanner.scan("int f(int a, ...) s.x..;");
+        EXPECT_TRUE(errors.empty());
+        EXPECT_EQ(tokens_to_string(tokens), expected);
+    }
+    EXPECT_EQ(longest_punctuation("...", 0, KIND_PUNCTUATOR), 3);
+    EXPECT_EQ(longest_punctuation("..", 0, KIND_PUNCTUATOR), 0);
+    EXPECT_EQ(longest_punctuation("..", 0, KIND_OPERATOR), 1);
+}
+
+// 测试分块并行扫描：块边界落在多行注释、字符串、运算符内部时结果仍与串行扫描逐项相同
+TEST(ScannerTest, ParallelScanMatchesSerial) {
+    const std::string code = "/* block\n comment // with\n \"quotes\" */ int a = 1;\n"
+            "char *s = \"line\\\n /* not comment */ \\x\";\n"
+            "x <<= 08 @ y; // tail \"\n"
+            "\ty\n>>=\n 'c' '\\q' \"unclosed\n";
+    utils::ThreadPool pool(3);
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const ScanResult serial = scanner.scan(code);
+        ASSERT_FALSE(serial.errors.empty());
+        for (size_t chunk_size = 1; chunk_size <= 40; ++chunk_size) {
+            const ScanResult parallel = scanner.scan_parallel(SourceBuffer::from_string(code), pool, chunk_size);
+            EXPECT_EQ(tokens_to_string(parallel.tokens), tokens_to_string(serial.tokens)) << chunk_size;
+            EXPECT_EQ(errors_to_string(parallel.errors), errors_to_string(serial.errors)) << chunk_size;
+            ASSERT_EQ(parallel.tokens.size(), serial.tokens.size());
+            for (size_t i = 0; i < serial.tokens.size(); ++i) {
+                EXPECT_EQ(parallel.offset(parallel.tokens[i]), serial.offset(serial.tokens[i]));
+            }
+        }
+    }
+    const Scanner scanner;
+    EXPECT_THROW((void) scanner.scan_parallel(SourceBuffer::from_string(code), pool, 0), std::invalid_argument);
+}
+
+// 测试按需计算的行列号：制表符占 4 列，换行后列号从 1 开始，错误位置与 Token 位置一致
+TEST(ScannerTest, LazyTokenPositions) {
+    const std::string code = "int a;\n\tb = 1;\n\n  c @";
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const ScanResult result = scanner.scan(code);
+        ASSERT_EQ(result.tokens.size(), 9);
+        const std::vector<std::pair<size_t, size_t> > expected{
+            {1, 1}, {1, 5}, {1, 6}, {2, 5}, {2, 7}, {2, 9}, {2, 10}, {4, 3}, {4, 5}
+        };
+        for (size_t i = 0; i < expected.size(); ++i) {
+            const auto [line, column] = result.position(result.tokens[i]);
+            EXPECT_EQ(std::make_pair(line, column), expected[i]) << i;
+        }
+        EXPECT_EQ(result.offset(result.tokens[3]), 8);
+        ASSERT_EQ(result.errors.size(), 1);
+        EXPECT_EQ(result.errors[0].line, 4);
+        EXPECT_EQ(result.errors[0].column, 5);
+    }
+    // 输入末尾之后的偏移落在最后一行
+    const auto source = SourceBuffer::from_string("a\nbc");
+    EXPECT_EQ(source->position(4).line, 2);
+    EXPECT_EQ(source->position(4).column, 3);
+    EXPECT_EQ(source->position(100).column, 3);
+}
+
+// 测试热点统计：成功尝试前进的字节数之和等于输入长度，未启用统计时接口返回空结果
+TEST(ScannerTest, MatcherStatistics) {
+    const std::string code = "int a = 1;\n@";
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const ScanResult result = scanner.scan(code);
+        if (!Scanner::STATS_ENABLED) {
+            EXPECT_TRUE(scanner.statistics().empty());
+            EXPECT_NE(scanner.dump_statistics().find("disabled"), std::string::npos);
+            continue;
+        }
+        const std::vector<MatcherStats> stats = scanner.statistics();
+        ASSERT_FALSE(stats.empty());
+        uint64_t bytes = 0;
+        for (const MatcherStats &item: stats) {
+            EXPECT_LE(item.hits, item.attempts) << item.name;
+            bytes += item.bytes;
+        }
+        EXPECT_EQ(bytes, code.size());
+        EXPECT_EQ(stats.back().name, "invalid");
+        EXPECT_EQ(stats.back().hits, 1);
+        const auto find = [&stats](const std::string &name) {
+            return *std::find_if(stats.begin(), stats.end(), [&name](const MatcherStats &item) {
+                return item.name == name;
+            });
+        };
+        EXPECT_EQ(find("identifier").hits, 2);
+        EXPECT_EQ(find("whitespace").bytes, 4);
+        if (mode == ScanMode::REGEX) {
+            // '1' 先尝试浮点匹配器，失败后由整数匹配器命中
+            EXPECT_EQ(find("float").attempts, 1);
+            EXPECT_EQ(find("float").hits, 0);
+        }
+        EXPECT_NE(scanner.dump_statistics().find("identifier"), std::string::npos);
+
+        scanner.reset_statistics();
+        for (const MatcherStats &item: scanner.statistics()) EXPECT_EQ(item.attempts, 0) << item.name;
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
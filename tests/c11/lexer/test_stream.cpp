@@ -0,0 +1,183 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <c11/lexer/scanner.hpp>
+#include <c11/lexer/stream.hpp>
+using namespace c11;
+
+
+// 辅助函数：将 Token 与其偏移、错误与其位置拼成字符串，便于和 Scanner::scan 的结果比较
+std::string describe_token(const Token &token, const size_t offset) {
+    std::stringstream ss;
+    ss << "[" << Scanner::token_type_to_string(token.type) << ":" << token.value << "@" << offset << "] ";
+    return ss.str();
+}
+
+std::string describe_errors(const std::vector<ScanError> &errors) {
+    std::stringstream ss;
+    for (const auto &error: errors) {
+        ss << "[" << Scanner::error_type_to_string(error.type) << " at (" << error.line << "," << error.column
+                << ")@" << error.offset << ": " << error.message << "] ";
+    }
+    return ss.str();
+}
+
+// 测试代码：覆盖多行注释、跨行字符串、制表符与各类错误
+const std::string stream_code = "/* head\n * more */\nint main(void) {\n"
+        "\tchar *s = \"a\\tb\\q\"; // tail\n"
+        "\tdouble d = 1.5e+3 + .25 + 08 @;\n"
+        "\treturn s[0] != 'a' && d >= 0x1F;\n"
+        "} \"unclosed";
+
+// 测试拉取式 Token 流与一次性扫描的结果逐项相同
+TEST(TokenStreamTest, PullMatchesScan) {
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const ScanResult expected = scanner.scan(stream_code);
+        std::string expected_tokens;
+        for (const Token &token: expected.tokens) expected_tokens += describe_token(token, expected.offset(token));
+
+        TokenStream stream(scanner, SourceBuffer::from_string(stream_code));
+        std::string tokens;
+        std::vector<ScanError> errors;
+        while (const auto token = stream.next_token()) {
+            tokens += describe_token(*token, stream.offset(*token));
+            errors.insert(errors.end(), stream.errors().begin(), stream.errors().end());
+        }
+        EXPECT_EQ(tokens, expected_tokens);
+        EXPECT_EQ(describe_errors(errors), describe_errors(expected.errors));
+        EXPECT_FALSE(stream.next_token().has_value());
+
+        // 范围 for 循环
+        TokenStream range(scanner, SourceBuffer::from_string(stream_code));
+        size_t count = 0;
+        for (const Token &token: range) {
+            EXPECT_EQ(token.value, expected.tokens[count].value);
+            count++;
+        }
+        EXPECT_EQ(count, expected.tokens.size());
+    }
+}
+
+// 测试分块输入：两种模式在任意分块大小下结果都与一次性扫描相同
+TEST(TokenStreamTest, ChunkedMatchesScan) {
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const ScanResult expected = scanner.scan(stream_code);
+        std::string expected_tokens;
+        for (const Token &token: expected.tokens) expected_tokens += describe_token(token, expected.offset(token));
+
+        for (size_t chunk = 1; chunk <= 40; ++chunk) {
+            ChunkedTokenStream stream(scanner);
+            std::string tokens;
+            std::vector<ScanError> errors;
+            // Token 只在下一次 feed 之前有效，立即转为字符串
+            const auto drain = [&] {
+                while (const auto token = stream.next_token()) {
+                    tokens += describe_token(*token, stream.offset(*token));
+                    errors.insert(errors.end(), stream.errors().begin(), stream.errors().end());
+                }
+            };
+            for (size_t pos = 0; pos < stream_code.size(); pos += chunk) {
+                stream.feed(std::string_view(stream_code).substr(pos, chunk));
+                drain();
+                EXPECT_FALSE(stream.exhausted());
+            }
+            stream.finish();
+            drain();
+            EXPECT_TRUE(stream.exhausted());
+            EXPECT_EQ(tokens, expected_tokens) << chunk;
+            EXPECT_EQ(describe_errors(errors), describe_errors(expected.errors)) << chunk;
+        }
+    }
+}
+
+// 测试分块输入在数据不足时等待：不会把 1.5e+3 拆开，也不会提前结束未闭合的注释
+TEST(TokenStreamTest, ChunkedWaitsForMoreInput) {
+    const Scanner scanner;
+    ChunkedTokenStream stream(scanner);
+    stream.feed("x = 1.5e");
+    // x 与 = 之后的字节已经到达，可以立即返回；1.5e 还可能延伸为 1.5e+3
+    EXPECT_EQ(stream.next_token()->value, "x");
+    EXPECT_EQ(stream.next_token()->value, "=");
+    EXPECT_FALSE(stream.next_token().has_value());
+    EXPECT_FALSE(stream.exhausted());
+    stream.feed("+3; /* comment that is still open ...................");
+    auto token = stream.next_token();
+    ASSERT_TRUE(token.has_value());
+    EXPECT_EQ(token->value, "1.5e+3");
+    EXPECT_EQ(stream.next_token()->value, ";");
+    EXPECT_FALSE(stream.next_token().has_value());
+    stream.feed(" */");
+    stream.finish();
+    token = stream.next_token();
+    ASSERT_TRUE(token.has_value());
+    EXPECT_EQ(token->type, TokenType::TOK_COMMENT);
+    EXPECT_EQ(stream.offset(*token), 12);
+    EXPECT_TRUE(stream.errors().empty());
+    EXPECT_FALSE(stream.next_token().has_value());
+    EXPECT_TRUE(stream.exhausted());
+    EXPECT_THROW(stream.feed("x"), std::logic_error);
+}
+
+// 测试分块输入的前瞻长度由规则表决定：1.5e+ 之后还要再读一个字节才能确定 Token
+TEST(TokenStreamTest, ChunkedLookaheadFollowsRules) {
+    EXPECT_EQ(Scanner::max_lookahead(), 3);
+    const Scanner scanner;
+    // e、+ 与 x 都已到达，足以确定 1.5 是完整的 Token
+    ChunkedTokenStream stream(scanner);
+    stream.feed("1.5e+x");
+    EXPECT_EQ(stream.next_token()->value, "1.5");
+    // 1.5e+3 之后还可能有数字
+    ChunkedTokenStream pending(scanner);
+    pending.feed("1.5e+3");
+    EXPECT_FALSE(pending.next_token().has_value());
+    pending.finish();
+    EXPECT_EQ(pending.next_token()->value, "1.5e+3");
+}
+
+// 测试长时间未闭合的注释以大量小块到达：撤销的步骤按翻倍重试，重新扫描次数与输入大小成对数关系，
+// 缓冲区原地压缩，容量始终不超过未消费数据的常数倍
+TEST(TokenStreamTest, ChunkedUnclosedCommentStaysLinear) {
+    const Scanner scanner;
+    const std::string line = "comment text\t\n";
+    constexpr size_t CHUNKS = 1 << 16;
+    const size_t total = 2 + CHUNKS * line.size();
+    size_t log2_total = 0;
+    while ((size_t{1} << log2_total) < total) ++log2_total;
+
+    ChunkedTokenStream stream(scanner);
+    stream.feed("/*");
+    for (size_t i = 0; i < CHUNKS; ++i) {
+        stream.feed(line);
+        EXPECT_FALSE(stream.next_token().has_value());
+        ASSERT_LE(stream.capacity(), 2 * stream.buffered() + 32) << i;
+    }
+    EXPECT_EQ(stream.buffered(), total);
+    EXPECT_LE(stream.rescans(), log2_total);
+    stream.finish();
+    const auto token = stream.next_token();
+
+    ASSERT_TRUE(token.has_value());
+    EXPECT_EQ(token->type, TokenType::TOK_UNKNOWN);
+    EXPECT_EQ(token->value.size(), total);
+    ASSERT_EQ(stream.errors().size(), 1);
+    EXPECT_EQ(stream.errors()[0].type, ErrorType::INCOMPLETE_COMMENT);
+    EXPECT_EQ(stream.errors()[0].line, 1);
+    EXPECT_FALSE(stream.next_token().has_value());
+    EXPECT_TRUE(stream.exhausted());
+
+    // 消费之后前缀被移除：剩余数据只有最后不足前瞻长度的部分
+    ChunkedTokenStream tokens(scanner);
+    for (size_t i = 0; i < CHUNKS; ++i) {
+        tokens.feed("x = y;\n");
+        while (tokens.next_token()) {}
+        ASSERT_LE(tokens.buffered(), 16) << i;
+        ASSERT_LE(tokens.capacity(), 64) << i;
+    }
+}
@@ -0,0 +1,64 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <c11/lexer/scanner.hpp>
+#include <c11/lexer/token_buffer.hpp>
+using namespace c11;
+
+
+// 测试结构数组输出与 Scanner::scan 的 Token 逐项相同，且跨越多个扫描窗口
+TEST(TokenBufferTest, MatchesScanResult) {
+    std::string code;
+    while (code.size() < 200 * 1024) {
+        code += "/* c */ int f(int x) {\n\treturn x << 2 @ \"s\\q\";\n}\n";
+    }
+    for (const ScanMode mode: {ScanMode::DFA, ScanMode::REGEX}) {
+        const Scanner scanner(mode);
+        const ScanResult expected = scanner.scan(code);
+        const TokenBuffer buffer = scanner.scan_token_buffer(expected.source, true);
+
+        ASSERT_EQ(buffer.size(), expected.tokens.size());
+        ASSERT_EQ(buffer.errors().size(), expected.errors.size());
+        EXPECT_TRUE(buffer.has_lines());
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            const TokenRef token = buffer[i];
+            ASSERT_EQ(token.type(), expected.tokens[i].type) << i;
+            ASSERT_EQ(token.value(), expected.tokens[i].value) << i;
+            ASSERT_EQ(token.offset(), expected.offset(expected.tokens[i])) << i;
+            ASSERT_EQ(token.line(), expected.position(expected.tokens[i]).line) << i;
+        }
+        for (size_t i = 0; i < expected.errors.size(); ++i) {
+            EXPECT_EQ(buffer.errors()[i].offset, expected.errors[i].offset);
+            EXPECT_EQ(buffer.errors()[i].line, expected.errors[i].line);
+        }
+    }
+}
+
+// 测试只读取类型列的统计，以及代理与迭代器
+TEST(TokenBufferTest, KindColumnAndProxy) {
+    const Scanner scanner;
+    const TokenBuffer buffer = scanner.scan_token_buffer(SourceBuffer::from_string("int a = (b + c) * d;"));
+    EXPECT_FALSE(buffer.has_lines());
+    EXPECT_TRUE(buffer.lines().empty());
+
+    const auto &kinds = buffer.kinds();
+    const auto count = [&kinds](const TokenType type) {
+        return std::count(kinds.begin(), kinds.end(), static_cast<uint8_t>(type));
+    };
+    EXPECT_EQ(count(TokenType::TOK_KEYWORD), 1);
+    EXPECT_EQ(count(TokenType::TOK_IDENTIFIER), 4);
+    EXPECT_EQ(count(TokenType::TOK_PUNCTUATOR), 3);
+
+    std::string joined;
+    for (const TokenRef token: buffer) {
+        joined += std::string(token.value()) + " ";
+        EXPECT_EQ(token.to_token().value, token.value());
+    }
+    EXPECT_EQ(joined, "int a = ( b + c ) * d ; ");
+    EXPECT_EQ(buffer[1].offset(), 4);
+    EXPECT_EQ(buffer[1].length(), 1);
+}
@@ -0,0 +1,242 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <lexer/regex/engine.hpp>
+using namespace lexer::regex;
+
+
+// 辅助函数：完整流水线编译正则为最小 DFA
+std::unique_ptr<DFA> compile(const std::string &regex) {
+    const auto dfa = build_dfa(regex_to_nfa(regex));
+    return minimize_dfa(*dfa);
+}
+
+// 测试连接、选择与闭包的组合
+TEST(RegexEngineTest, BasicOperators) {
+    const auto concat = compile("ab");
+    EXPECT_TRUE(match(*concat, "ab"));
+    EXPECT_FALSE(match(*concat, "a"));
+
+    const auto alternative = compile("(ab)*(c|d)");
+    EXPECT_TRUE(match(*alternative, "c"));
+    EXPECT_TRUE(match(*alternative, "ababd"));
+    EXPECT_FALSE(match(*alternative, "abab"));
+    EXPECT_FALSE(match(*alternative, "abd d"));
+}
+
+// 测试元字符转义
+TEST(RegexEngineTest, EscapedMetaChars) {
+    const auto dfa = compile("\\*\\(|\\|");
+    EXPECT_TRUE(match(*dfa, "*("));
+    EXPECT_TRUE(match(*dfa, "|"));
+    EXPECT_FALSE(match(*dfa, "*"));
+}
+
+// 测试多规则合并后的最长匹配与规则优先级
+TEST(RegexEngineTest, LongestMatchWithRulePriority) {
+    std::vector<std::unique_ptr<NFA> > rules;
+    rules.push_back(regex_to_nfa("if"));
+    rules.push_back(regex_to_nfa("(i|f)(i|f|x)*"));
+    rules.push_back(regex_to_nfa("<|<<|<<=|<="));
+    const auto dfa = minimize_dfa(*build_dfa(combine_rules(std::move(rules))));
+
+    // 长度相同时取编号较小的规则
+    auto result = longest_match(*dfa, "if", 0);
+    EXPECT_EQ(result.length, 2);
+    EXPECT_EQ(result.rule, 0);
+    // 更长的匹配优先于规则编号
+    result = longest_match(*dfa, "iff x", 0);
+    EXPECT_EQ(result.length, 3);
+    EXPECT_EQ(result.rule, 1);
+    result = longest_match(*dfa, "a <<=3", 2);
+    EXPECT_EQ(result.length, 3);
+    EXPECT_EQ(result.rule, 2);
+    // 无匹配
+    result = longest_match(*dfa, "x", 0);
+    EXPECT_EQ(result.length, 0);
+    EXPECT_EQ(result.rule, -1);
+}
+
+// 测试冻结后的稠密转移表与原 DFA 的匹配结果一致
+TEST(RegexEngineTest, DenseTableMatchesDFA) {
+    const auto dfa = compile("(ab)*(c|d)|x*");
+    const DenseDFA dense = freeze_dfa(*dfa);
+
+    EXPECT_EQ(dense.state_count, dfa->states.size() + 1);
+    EXPECT_EQ(dense.next.size(), dense.state_count * DenseDFA::ALPHABET_SIZE);
+    for (const std::string input: {"", "c", "ababd", "abab", "xxx", "xa", "\xff"}) {
+        EXPECT_EQ(match(dense, input), match(*dfa, input)) << input;
+        const auto expected = longest_match(*dfa, input, 0);
+        const auto actual = longest_match(dense, input, 0);
+        EXPECT_EQ(actual.length, expected.length) << input;
+        EXPECT_EQ(actual.rule, expected.rule) << input;
+    }
+}
+
+// 测试字节等价类与压缩转移表
+TEST(RegexEngineTest, ByteClassCompression) {
+    const auto dfa = compile("(a|b|c)(a|b|c|0|1)*");
+    // 等价类：{a,b,c}、{0,1}、其余字节
+    EXPECT_EQ(dfa->byte_classes.count, 3);
+    EXPECT_EQ(dfa->byte_classes.of('a'), dfa->byte_classes.of('c'));
+    EXPECT_EQ(dfa->byte_classes.of('0'), dfa->byte_classes.of('1'));
+    EXPECT_NE(dfa->byte_classes.of('a'), dfa->byte_classes.of('0'));
+    EXPECT_EQ(dfa->byte_classes.of('x'), dfa->byte_classes.of('\0'));
+
+    const CompactDFA compact = compress_dfa(*dfa);
+    EXPECT_EQ(compact.next.size(), compact.state_count * compact.classes.count);
+    for (const std::string input: {"", "a", "ab01c", "0a", "abx", "c1"}) {
+        EXPECT_EQ(match(compact, input), match(*dfa, input)) << input;
+        EXPECT_EQ(longest_match(compact, input, 0).length, longest_match(*dfa, input, 0).length) << input;
+    }
+
+    // 手工构建的 DFA 没有计算 byte_classes，压缩时按实际转移重新计算字节类
+    DFA manual;
+    DFAState *first = manual.add_state(std::make_unique<DFAState>(false));
+    DFAState *second = manual.add_state(std::make_unique<DFAState>(true));
+    first->transitions['a'] = second;
+    second->transitions['z'] = second;
+    manual.start = first;
+    EXPECT_EQ(manual.byte_classes.count, 1);
+    const CompactDFA manual_compact = compress_dfa(manual);
+    EXPECT_EQ(manual_compact.classes.count, 3);
+    EXPECT_TRUE(match(manual_compact, "azz"));
+    EXPECT_FALSE(match(manual_compact, "zz"));
+    EXPECT_FALSE(match(manual_compact, "aa"));
+}
+
+// 测试最小化：状态数最小，且与未最小化的 DFA 接受相同的语言
+TEST(RegexEngineTest, MinimizeKeepsLanguage) {
+    const auto dfa = build_dfa(regex_to_nfa("(a|b)*abb|(ab|ba)*c"));
+    const auto min_dfa = minimize_dfa(*dfa);
+    EXPECT_LE(min_dfa->states.size(), dfa->states.size());
+    EXPECT_EQ(minimize_dfa(*build_dfa(regex_to_nfa("(a|b)*abb")))->states.size(), 4);
+
+    // 穷举长度不超过 6 的所有 {a,b,c} 串
+    std::vector<std::string> inputs = {""};
+    for (size_t begin = 0, length = 0; length < 6; ++length) {
+        const size_t end = inputs.size();
+        for (size_t i = begin; i < end; ++i) {
+            for (const char c: {'a', 'b', 'c'}) inputs.push_back(inputs[i] + c);
+        }
+        begin = end;
+    }
+    for (const auto &input: inputs) {
+        EXPECT_EQ(match(*min_dfa, input), match(*dfa, input)) << input;
+    }
+}
+
+// 测试大规模选择的子集构造：所有关键字与运算符合并为一个正则
+TEST(RegexEngineTest, LargeAlternation) {
+    const std::vector<std::string> words = {
+        "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+        "extern", "float", "for", "goto", "if", "int", "long", "register", "return", "short", "signed",
+        "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void", "volatile", "while",
+        "->", "\\+\\+", "--", "<=", ">=", "==", "!=", "&&", "\\|\\|", "<<=", ">>=", "<<", ">>"
+    };
+    std::string regex;
+    for (const auto &word: words) regex += (regex.empty() ? "" : "|") + word;
+    const auto dfa = compile(regex);
+
+    for (const std::string input: {"auto", "unsigned", "while", "<<=", "||", "->", "do"}) {
+        EXPECT_TRUE(match(*dfa, input)) << input;
+    }
+    for (const std::string input: {"aut", "unsignedx", "<<<", "|", "d"}) {
+        EXPECT_FALSE(match(*dfa, input)) << input;
+    }
+}
+
+// 测试 NFA 竞技场：状态数量与 Thompson 构造一致，多规则合并后的下标重定位正确
+TEST(RegexEngineTest, ArenaNFALayout) {
+    EXPECT_EQ(regex_to_nfa("ab")->states.size(), 4);
+    EXPECT_EQ(regex_to_nfa("a|b")->states.size(), 6);
+    EXPECT_EQ(regex_to_nfa("(ab)*")->states.size(), 6);
+
+    const auto nfa = regex_to_nfa("(ab|c)*d");
+    EXPECT_TRUE(nfa->states[nfa->end].is_accept);
+    for (const auto &state: nfa->states) {
+        if (state.has_label()) {
+            EXPECT_LT(state.out, static_cast<int>(nfa->states.size()));
+        }
+    }
+
+    std::vector<std::unique_ptr<NFA> > rules;
+    rules.push_back(regex_to_nfa("ab"));
+    rules.push_back(regex_to_nfa("a|b"));
+    rules.push_back(regex_to_nfa("c"));
+    const auto combined = combine_rules(std::move(rules));
+    // 三个规则共 12 个状态，外加三个分支状态
+    EXPECT_EQ(combined->states.size(), 15);
+    EXPECT_EQ(combined->end, NFAState::NONE);
+    const auto dfa = build_dfa(combined);
+    EXPECT_EQ(longest_match(*dfa, "ab", 0).rule, 0);
+    EXPECT_EQ(longest_match(*dfa, "b", 0).rule, 1);
+    EXPECT_EQ(longest_match(*dfa, "c", 0).rule, 2);
+}
+
+// 测试字符类与 . 折叠为一条带标签的边
+TEST(RegexEngineTest, CharacterClasses) {
+    EXPECT_EQ(regex_to_nfa("[a-z]")->states.size(), 2);
+    EXPECT_EQ(regex_to_nfa(".")->states.size(), 2);
+
+    const auto identifier = compile("[a-zA-Z_][a-zA-Z0-9_]*");
+    EXPECT_TRUE(match(*identifier, "_foo42"));
+    EXPECT_FALSE(match(*identifier, "4foo"));
+    // 最小 DFA 只需两个状态，字节等价类为：首字符、仅后续字符（数字）、其他
+    EXPECT_EQ(identifier->states.size(), 2);
+    EXPECT_EQ(identifier->byte_classes.count, 3);
+
+    const auto negated = compile("[^a-c\\]]+");
+    EXPECT_TRUE(match(*negated, "xyz-"));
+    EXPECT_FALSE(match(*negated, "xbz"));
+    EXPECT_FALSE(match(*negated, "x]"));
+
+    const auto literal = compile("[]a-][.]");
+    EXPECT_TRUE(match(*literal, "]."));
+    EXPECT_TRUE(match(*literal, "-."));
+    EXPECT_FALSE(match(*literal, "bx"));
+
+    const auto dot = compile("a.c");
+    EXPECT_TRUE(match(*dot, "a*c"));
+    EXPECT_FALSE(match(*dot, "a\nc"));
+
+    EXPECT_THROW(regex_to_nfa("[abc"), std::invalid_argument);
+    EXPECT_THROW(regex_to_nfa("[z-a]"), std::invalid_argument);
+}
+
+// 测试 +、? 与 {m,n} 重复
+TEST(RegexEngineTest, Quantifiers) {
+    const auto plus = compile("(ab)+c?");
+    EXPECT_TRUE(match(*plus, "ab"));
+    EXPECT_TRUE(match(*plus, "ababc"));
+    EXPECT_FALSE(match(*plus, "c"));
+
+    const auto bounded = compile("x[0-7]{1,3}");
+    EXPECT_TRUE(match(*bounded, "x7"));
+    EXPECT_TRUE(match(*bounded, "x777"));
+    EXPECT_FALSE(match(*bounded, "x"));
+    EXPECT_FALSE(match(*bounded, "x7777"));
+
+    const auto exact = compile("(ab|c){2}");
+    EXPECT_TRUE(match(*exact, "abc"));
+    EXPECT_FALSE(match(*exact, "ab"));
+
+    const auto at_least = compile("a{2,}");
+    EXPECT_FALSE(match(*at_least, "a"));
+    EXPECT_TRUE(match(*at_least, "aaaaa"));
+
+    const auto escaped = compile("\\{\\+\\?\\.");
+    EXPECT_TRUE(match(*escaped, "{+?."));
+
+    EXPECT_THROW(regex_to_nfa("{2}"), std::invalid_argument);
+    EXPECT_THROW(regex_to_nfa("a{3,1}"), std::invalid_argument);
+    EXPECT_THROW(regex_to_nfa("a{x}"), std::invalid_argument);
+    // 嵌套重复按乘积展开，超过上限时拒绝而不是无限制地分配
+    EXPECT_THROW(regex_to_nfa("(a{1000}){1000}"), std::invalid_argument);
+    EXPECT_NO_THROW(regex_to_nfa("(a{100}){100}"));
+}
@@ -0,0 +1,74 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <lexer/regex/engine.hpp>
+#include <lexer/regex/lazy.hpp>
+using namespace lexer::regex;
+
+
+// 测试惰性 DFA 与完整构造的 DFA 结果一致
+TEST(LazyDFATest, MatchesEagerDFA) {
+    const std::string regex = "(a|b)*a(a|b)(a|b)(a|b)|c*";
+    const auto dfa = minimize_dfa(*build_dfa(regex_to_nfa(regex)));
+    LazyDFA lazy(regex_to_nfa(regex));
+
+    for (const std::string input: {"", "abbb", "babab", "bbbb", "ccc", "cab", "aaaaaaaab"}) {
+        EXPECT_EQ(lazy.match(input), match(*dfa, input)) << input;
+        EXPECT_EQ(lazy.longest_match(input, 0).length, longest_match(*dfa, input, 0).length) << input;
+    }
+}
+
+// 测试只构造输入到达的状态
+TEST(LazyDFATest, MaterializesOnDemand) {
+    LazyDFA lazy(regex_to_nfa("(a|b)*a(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)"));
+    // 初始只有死状态与起始状态
+    EXPECT_EQ(lazy.cached_states(), 2);
+    EXPECT_FALSE(lazy.match("bbbb"));
+    const size_t after_b = lazy.cached_states();
+    EXPECT_FALSE(lazy.match("bbbb"));
+    // 重复的输入不会再构造新状态
+    EXPECT_EQ(lazy.cached_states(), after_b);
+    EXPECT_TRUE(lazy.match("ababababa"));
+    EXPECT_GT(lazy.cached_states(), after_b);
+}
+
+// 测试超过内存预算时清空缓存，匹配结果不受影响
+TEST(LazyDFATest, FlushesWhenOverBudget) {
+    const std::string regex = "(a|b)*a(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)";
+    const auto dfa = build_dfa(regex_to_nfa(regex));
+    LazyDFA lazy(regex_to_nfa(regex), 2048);
+
+    // 伪随机输入，覆盖尽可能多的后缀状态
+    std::string input;
+    uint32_t seed = 12345;
+    for (int i = 0; i < 512; ++i) {
+        seed = seed * 1103515245 + 12345;
+        input += (seed >> 16) & 1 ? 'a' : 'b';
+    }
+    for (size_t length = 0; length <= input.size(); length += 37) {
+        const std::string_view prefix(input.data(), length);
+        EXPECT_EQ(lazy.match(prefix), match(*dfa, prefix)) << length;
+    }
+    EXPECT_GT(lazy.flush_count(), 0);
+    EXPECT_LE(lazy.cache_bytes(), 2048 + 1024);
+}
+
+// 测试多规则合并后的惰性最长匹配
+TEST(LazyDFATest, LongestMatchWithRules) {
+    std::vector<std::unique_ptr<NFA> > rules;
+    rules.push_back(regex_to_nfa("if"));
+    rules.push_back(regex_to_nfa("(i|f)(i|f|x)*"));
+    LazyDFA lazy(combine_rules(std::move(rules)));
+
+    auto result = lazy.longest_match("if", 0);
+    EXPECT_EQ(result.length, 2);
+    EXPECT_EQ(result.rule, 0);
+    result = lazy.longest_match("x iffx+", 2);
+    EXPECT_EQ(result.length, 4);
+    EXPECT_EQ(result.rule, 1);
+}
@@ -0,0 +1,52 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <lexer/regex/engine.hpp>
+#include <lexer/regex/regex_set.hpp>
+using namespace lexer::regex;
+
+
+// 测试一次扫描得到的模式编号与逐个模式匹配的结果一致
+TEST(RegexSetTest, MatchesEachPattern) {
+    const std::vector<std::string> patterns = {
+        "if", "[a-z]+", "i.*", "[0-9]+", "0x[0-9a-f]+", "(ab)*", "a(a|b)(a|b)", "x*"
+    };
+    const RegexSet set(patterns);
+    EXPECT_EQ(set.size(), patterns.size());
+
+    std::vector<std::unique_ptr<DFA> > dfas;
+    for (const auto &pattern: patterns) dfas.push_back(minimize_dfa(*build_dfa(regex_to_nfa(pattern))));
+    for (const std::string input: {"", "if", "iff", "i9", "123", "0x1f", "abab", "aba", "abb", "xxx", "?"}) {
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < dfas.size(); ++i) {
+            if (match(*dfas[i], input)) expected.push_back(i);
+        }
+        EXPECT_EQ(set.matches(input), expected) << input;
+        EXPECT_EQ(set.is_match(input), !expected.empty()) << input;
+    }
+    // "if" 同时命中字面量、小写单词与 i 开头的模式
+    EXPECT_EQ(set.matches("if"), (std::vector<size_t>{0, 1, 2}));
+}
+
+// 测试超过 64 个模式时位集跨越多个字
+TEST(RegexSetTest, ManyPatterns) {
+    std::vector<std::string> patterns;
+    for (int i = 0; i < 200; ++i) patterns.push_back("key" + std::to_string(i) + "(_[a-z]+)?");
+    patterns.emplace_back("key[0-9]+(_[a-z]+)?");
+    const RegexSet set(patterns);
+    EXPECT_EQ(set.matches("key150_value"), (std::vector<size_t>{150, 200}));
+    EXPECT_EQ(set.matches("key7"), (std::vector<size_t>{7, 200}));
+    EXPECT_EQ(set.matches("key999"), (std::vector<size_t>{200}));
+    EXPECT_FALSE(set.is_match("key_"));
+}
+
+// 测试空模式列表与非法模式
+TEST(RegexSetTest, InvalidPatterns) {
+    EXPECT_THROW(RegexSet(std::vector<std::string>{}), std::invalid_argument);
+    EXPECT_THROW(RegexSet(std::vector<std::string>{"a", "(b"}), std::invalid_argument);
+}
@@ -0,0 +1,85 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <lexer/regex/rule_lexer.hpp>
+using namespace lexer::regex;
+
+namespace {
+    enum Kind { KEYWORD, IDENTIFIER, NUMBER, OPERATOR, SPACE };
+
+    RuleLexer make_lexer() {
+        return RuleLexer({
+            {"if|while", KEYWORD},
+            {"[a-z][a-z0-9]*", IDENTIFIER},
+            {"[0-9]+", NUMBER},
+            {"<|<=|<<|=", OPERATOR},
+            {"[ ]+", SPACE},
+        });
+    }
+
+    // 用 next_token 驱动整个输入，返回 "种类:文本" 序列，没有规则匹配时记为 "?"
+    std::vector<std::string> drive(const RuleLexer &lexer, const std::string_view input) {
+        std::vector<std::string> tokens;
+        size_t pos = 0;
+        while (pos < input.size()) {
+            const LexMatch match = lexer.next_token(input, pos);
+            if (match.length == 0) {
+                tokens.emplace_back("?");
+                ++pos;
+                continue;
+            }
+            if (match.kind != SPACE) {
+                tokens.push_back(std::to_string(match.kind) + ":" + std::string(input.substr(pos, match.length)));
+            }
+            pos += match.length;
+        }
+        return tokens;
+    }
+}
+
+
+// 测试最长匹配与同长度时的规则优先级
+TEST(RuleLexerTest, MaximalMunchWithPriority) {
+    const RuleLexer lexer = make_lexer();
+    EXPECT_EQ(drive(lexer, "if iffy <<= x1 while 42"),
+              (std::vector<std::string>{"0:if", "1:iffy", "3:<<", "3:=", "1:x1", "0:while", "2:42"}));
+    EXPECT_EQ(drive(lexer, "a@b"), (std::vector<std::string>{"1:a", "?", "1:b"}));
+
+    const LexMatch match = lexer.next_token("while", 0);
+    EXPECT_EQ(match.length, 5);
+    EXPECT_EQ(match.rule, 0);
+    EXPECT_EQ(match.kind, KEYWORD);
+    EXPECT_EQ(lexer.next_token("x <= 1", 2).length, 2);
+    EXPECT_EQ(lexer.rules().size(), 5);
+}
+
+// 测试越过 Token 末尾的最大读取字节数
+TEST(RuleLexerTest, MaxLookahead) {
+    // 匹配 a 之后还要读 b、c 与第三个字节才能确定是否为 abcd
+    EXPECT_EQ(RuleLexer({{"a", 0}, {"abcd", 1}}).max_lookahead(), 3);
+    EXPECT_EQ(RuleLexer({{"[a-z]+", 0}}).max_lookahead(), 1);
+    // 起始状态出发、没有任何匹配时的读取同样计入
+    EXPECT_EQ(RuleLexer({{"xyz", 0}}).max_lookahead(), 3);
+    // 非接受状态之间有环：读取没有上界
+    EXPECT_EQ(RuleLexer({{"a", 0}, {"ab*c", 1}}).max_lookahead(), RuleLexer::UNBOUNDED);
+    EXPECT_EQ(make_lexer().max_lookahead(), 1);
+}
+
+// 测试只能匹配空串的规则不会产生 Token，以及非法规则表
+TEST(RuleLexerTest, EmptyMatchesAndInvalidRules) {
+    const RuleLexer lexer({{"a*", 7}, {"b", 8}});
+    EXPECT_EQ(lexer.next_token("aab", 0).kind, 7);
+    EXPECT_EQ(lexer.next_token("aab", 2).kind, 8);
+    const LexMatch none = lexer.next_token("c", 0);
+    EXPECT_EQ(none.length, 0);
+    EXPECT_EQ(none.rule, -1);
+    EXPECT_EQ(none.kind, -1);
+
+    EXPECT_THROW(RuleLexer(std::vector<LexRule>{}), std::invalid_argument);
+    EXPECT_THROW(RuleLexer({{"(a", 0}}), std::invalid_argument);
+}
@@ -0,0 +1,75 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <lexer/simd/skip.hpp>
+using namespace lexer::simd;
+
+
+// 辅助函数：按字母表生成伪随机输入，覆盖向量边界与尾部
+std::string random_input(const std::string &alphabet, const size_t length, uint32_t seed) {
+    std::string input;
+    for (size_t i = 0; i < length; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        input += alphabet[(seed >> 16) % alphabet.size()];
+    }
+    return input;
+}
+
+// 测试各指令集的内核与标量内核在所有起始位置上的结果一致
+TEST(SkipKernelsTest, VectorMatchesScalar) {
+    const SkipKernels &reference = kernels_for(Isa::SCALAR);
+    // 偏向命中的字母表，包含高位字节以检查有符号比较
+    const std::string alphabet = std::string("  \t\n\r\fabzAZ09_*/\"'\\x") + '\x80' + '\xff' + '\x7f';
+    for (const Isa isa: {Isa::SSE2, Isa::AVX2}) {
+        const SkipKernels &kernels = kernels_for(isa);
+        for (uint32_t seed = 1; seed <= 20; ++seed) {
+            const std::string input = random_input(alphabet, 150, seed);
+            const char *data = input.data();
+            const size_t size = input.size();
+            for (size_t pos = 0; pos <= size; ++pos) {
+                EXPECT_EQ(kernels.skip_whitespace(data, size, pos), reference.skip_whitespace(data, size, pos));
+                EXPECT_EQ(kernels.skip_identifier(data, size, pos), reference.skip_identifier(data, size, pos));
+                EXPECT_EQ(kernels.find_byte(data, size, pos, '"'), reference.find_byte(data, size, pos, '"'));
+                EXPECT_EQ(kernels.find_comment_end(data, size, pos), reference.find_comment_end(data, size, pos));
+                EXPECT_EQ(kernels.find_quote_end(data, size, pos, '"'), reference.find_quote_end(data, size, pos, '"'));
+            }
+        }
+    }
+}
+
+// 测试长段输入与向量边界上的匹配
+TEST(SkipKernelsTest, LongRunsAndBoundaries) {
+    EXPECT_EQ(kernels().isa, detect_isa());
+    const std::string spaces(100, ' ');
+    EXPECT_EQ(skip_whitespace(spaces + "x", 0), 100);
+    EXPECT_EQ(skip_whitespace(spaces, 7), 100);
+
+    const std::string identifier = std::string(70, 'a') + "_Z9";
+    EXPECT_EQ(skip_identifier(identifier + "+", 0), identifier.size());
+    EXPECT_EQ(skip_identifier(identifier + "\xc3\xa9", 0), identifier.size());
+
+    // "*/" 横跨 16 与 32 字节边界
+    for (const size_t star: {15, 31, 63}) {
+        std::string comment(80, '*');
+        comment[star + 1] = '/';
+        EXPECT_EQ(find_comment_end(comment, 0), star) << star;
+    }
+    EXPECT_EQ(find_comment_end(std::string(40, '*'), 0), 40);
+    EXPECT_EQ(find_comment_end("/", 0), 1);
+
+    const std::string line = std::string(50, '/') + "\n";
+    EXPECT_EQ(find_byte(line, 0, '\n'), 50);
+    EXPECT_EQ(find_byte(line, 0, '"'), line.size());
+
+    // 连续反斜杠按奇偶判断：偶数个时引号未被转义，奇数个时被转义；反斜杠横跨向量边界
+    for (const size_t run: {1, 2, 3, 4, 15, 16, 17, 32, 33}) {
+        const std::string text = std::string(30, 'a') + std::string(run, '\\') + "\"" + std::string(40, 'b') + "\"";
+        const size_t expected = run % 2 == 0 ? 30 + run : text.size() - 1;
+        EXPECT_EQ(find_quote_end(text, 0, '"'), expected) << run;
+    }
+    EXPECT_EQ(find_quote_end("ab\\", 0, '"'), 3);
+}
@@ -0,0 +1,29 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <utils/arena.hpp>
+using namespace utils;
+
+
+// 测试拼接结果，以及跨越多个内存块后之前的地址仍然有效
+TEST(ArenaTest, ConcatKeepsEarlierViews) {
+    Arena arena(64);
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 1000; ++i) {
+        const std::string number = std::to_string(i);
+        views.push_back(arena.concat({"Invalid integer literal ('", number, "')"}));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(views[i], "Invalid integer literal ('" + std::to_string(i) + "')");
+    }
+    EXPECT_EQ(arena.store("").size(), 0);
+
+    // 超过块大小的请求单独占一块
+    const std::string large(3 * Arena::MAX_BLOCK, 'x');
+    EXPECT_EQ(arena.store(large), large);
+    EXPECT_EQ(views.front(), "Invalid integer literal ('0')");
+}
@@ -0,0 +1,82 @@
+//
+// Created by aowei on 2026 10月 15.
+//
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <vector>
+#include <utils/thread_pool.hpp>
+using namespace utils;
+
+
+// 测试任务结果与执行次数
+TEST(ThreadPoolTest, SubmitReturnsResults) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    std::atomic<int> executed{0};
+    std::vector<std::future<int> > results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(pool.submit([i, &executed] {
+            ++executed;
+            return i * i;
+        }));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(results[i].get(), i * i);
+    }
+    EXPECT_EQ(executed.load(), 100);
+}
+
+// 测试任务异常经 future 传回，且不影响后续任务
+TEST(ThreadPoolTest, ExceptionPropagates) {
+    ThreadPool pool(2);
+    auto failed = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    EXPECT_EQ(pool.submit([] { return 7; }).get(), 7);
+}
+
+// 测试析构时执行完剩余任务
+TEST(ThreadPoolTest, DrainsOnDestruction) {
+    std::atomic<int> executed{0};
+    {
+        ThreadPool pool(1);
+        for (int i = 0; i < 50; ++i) {
+            pool.submit([&executed] { ++executed; });
+        }
+    }
+    EXPECT_EQ(executed.load(), 50);
+}
+
+// 测试工作窃取：一个线程被长任务占住时，轮转到它队列里的任务由其他线程窃取执行，不会被卡住
+TEST(ThreadPoolTest, IdleWorkersStealQueuedJobs) {
+    ThreadPool pool(2);
+    constexpr int count = 20;
+    std::atomic<int> executed{0};
+    std::promise<void> all_done;
+    // 第一个任务占住一个线程，直到其余任务全部完成
+    auto blocker = pool.submit([&all_done] {
+        all_done.get_future().wait_for(std::chrono::seconds(5));
+    });
+    std::vector<std::future<void> > jobs;
+    for (int i = 0; i < count; ++i) {
+        jobs.push_back(pool.submit([&executed] { ++executed; }));
+    }
+    for (auto &job: jobs) {
+        EXPECT_EQ(job.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    }
+    EXPECT_EQ(executed.load(), count);
+    all_done.set_value();
+    blocker.get();
+}
+
+// 测试任务内部提交的子任务
+TEST(ThreadPoolTest, NestedSubmit) {
+    ThreadPool pool(2);
+    auto outer = pool.submit([&pool] {
+        return pool.submit([] { return 21; });
+    });
+    EXPECT_EQ(outer.get().get() * 2, 42);
+}